@@ -0,0 +1,60 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "BenchHarness.h"
+
+// C++ Standard Library includes
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/** The number of heap allocations performed so far. */
+static std::atomic<size_t> allocationCount(0);
+
+void* operator new(size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace astu::suite2d::bench {
+
+    size_t GetAllocationCount()
+    {
+        return allocationCount.load(std::memory_order_relaxed);
+    }
+
+} // end of namespace
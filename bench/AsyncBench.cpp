@@ -0,0 +1,79 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "BenchHarness.h"
+
+// C++ Standard Library includes
+#include <string>
+
+using namespace std;
+
+namespace astu::suite2d::bench {
+
+    static const int NUM_FRAMES = 300;
+    static const int BASE = 40;
+
+    /** The simulated work of the rest of the frame in milliseconds. */
+    static const double RENDER_TIME = 4.0;
+
+    /**
+     * Busy-waits to simulate the work of other systems, e.g., rendering.
+     *
+     * @param ms    the time to spend in milliseconds
+     */
+    static void SimulateRenderWork(double ms)
+    {
+        StopWatch watch;
+        while (watch.GetMilliseconds() < ms) {
+            // Spin.
+        }
+    }
+
+    /**
+     * Runs a pyramid scene with simulated render work per frame.
+     *
+     * @param report    receives the measurements
+     * @param async     whether to step asynchronously
+     */
+    static void RunFrames(BenchReport& report, bool async)
+    {
+        BenchHarness harness;
+        harness.GetPhysics().SetGravityVector(0, -10.0f);
+        harness.GetPhysics().SetAsyncStep(async);
+        harness.Add(harness.CreateBox(0, -0.5f, 200, 1, CBody::Type::Static));
+
+        for (int row = 0; row < BASE; ++row) {
+            int n = BASE - row;
+            float x0 = -0.5f * (n - 1);
+            for (int i = 0; i < n; ++i) {
+                harness.Add(harness.CreateBox(x0 + i, 0.5f + row, 1, 1, CBody::Type::Dynamic));
+            }
+        }
+
+        double updateTime = 0;
+        StopWatch frameWatch;
+        for (int i = 0; i < NUM_FRAMES; ++i) {
+            StopWatch watch;
+            harness.Update();
+            updateTime += watch.GetMilliseconds();
+            SimulateRenderWork(RENDER_TIME);
+        }
+        double frameTime = frameWatch.GetMilliseconds();
+
+        const string scenario = async ? "async" : "async_baseline";
+        report.Record(scenario, "update_time", updateTime / NUM_FRAMES, "ms");
+        report.Record(scenario, "frame_time", frameTime / NUM_FRAMES, "ms");
+    }
+
+    void RunAsyncBench(BenchReport& report)
+    {
+        RunFrames(report, false);
+        RunFrames(report, true);
+    }
+
+} // end of namespace
@@ -0,0 +1,241 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "BenchHarness.h"
+
+// AST-Utilities includes
+#include <Service/Service.h>
+#include <Service/UpdateService.h>
+#include <Service/TimeService.h>
+#include <Suite2D/CPose.h>
+#include <Math/Polygon.h>
+
+// C++ Standard Library includes
+#include <iostream>
+
+using namespace std;
+
+namespace astu::suite2d::bench {
+
+    /**
+     * Time service which advances time in constant steps.
+     */
+    class FixedTimeService
+        : public BaseService
+        , public TimeService
+        , private Updatable
+    {
+    public:
+
+        FixedTimeService(double dt)
+            : BaseService("Fixed Time Service")
+            , Updatable(Priority::Highest)
+            , dt(dt)
+            , elapsed(0)
+            , absolute(0)
+        {
+            // Intentionally left empty.
+        }
+
+        // Inherited via TimeService
+        virtual double GetElapsedTime() const override {
+            return elapsed;
+        }
+
+        virtual double GetAbsoluteTime() const override {
+            return absolute;
+        }
+
+    private:
+        /** The elapsed time per update. */
+        double dt;
+
+        /** The elapsed time of the current update. */
+        double elapsed;
+
+        /** The absolute time since startup. */
+        double absolute;
+
+        // Inherited via Updatable
+        virtual void OnUpdate() override {
+            elapsed = dt;
+            absolute += dt;
+        }
+    };
+
+    BenchHarness::BenchHarness(double dt)
+    {
+        auto& sm = ServiceManager::GetInstance();
+        updater = make_shared<UpdateService>();
+        sm.AddService(updater);
+        sm.AddService(make_shared<FixedTimeService>(dt));
+
+        entities = make_shared<EntityService>();
+        sm.AddService(entities);
+
+        physics = make_shared<Box2DPhysicsSystem>();
+        physics->SetProfiling(true);
+        sm.AddService(physics);
+
+        sm.StartupAll();
+    }
+
+    BenchHarness::~BenchHarness()
+    {
+        auto& sm = ServiceManager::GetInstance();
+        sm.ShutdownAll();
+        sm.RemoveAll();
+    }
+
+    shared_ptr<Entity> BenchHarness::CreateCircle(float x, float y, float radius, CBody::Type type)
+    {
+        auto entity = make_shared<Entity>();
+
+        auto pose = make_shared<CPose>();
+        pose->transform.SetTranslation(x, y);
+        entity->AddComponent(pose);
+
+        auto body = physics->CreateBody();
+        body->SetType(type);
+        entity->AddComponent(body);
+
+        auto collider = physics->CreateCircleCollider();
+        collider->SetRadius(radius);
+        entity->AddComponent(collider);
+
+        return entity;
+    }
+
+    shared_ptr<Entity> BenchHarness::CreateBox(float x, float y, float w, float h, CBody::Type type)
+    {
+        static shared_ptr<Polygon> unitBox;
+        if (!unitBox) {
+            unitBox = make_shared<Polygon>();
+            unitBox->AddVertex(-0.5f, -0.5f);
+            unitBox->AddVertex( 0.5f, -0.5f);
+            unitBox->AddVertex( 0.5f,  0.5f);
+            unitBox->AddVertex(-0.5f,  0.5f);
+        }
+
+        auto entity = make_shared<Entity>();
+
+        auto pose = make_shared<CPose>();
+        pose->transform.SetTranslation(x, y);
+        entity->AddComponent(pose);
+
+        auto body = physics->CreateBody();
+        body->SetType(type);
+        entity->AddComponent(body);
+
+        auto polygon = make_shared<Polygon>(*unitBox);
+        polygon->Scale(w, h);
+        auto collider = physics->CreatePolygonCollider();
+        collider->SetPolygon(polygon);
+        entity->AddComponent(collider);
+
+        return entity;
+    }
+
+    void BenchHarness::Add(shared_ptr<Entity> entity)
+    {
+        entities->AddEntity(entity);
+    }
+
+    void BenchHarness::Remove(shared_ptr<Entity> entity)
+    {
+        entities->RemoveEntity(entity);
+    }
+
+    void BenchHarness::Update()
+    {
+        updater->UpdateAll();
+    }
+
+    void BenchReport::Record(const string& scenario, const string& metric, double value, const string& unit)
+    {
+        if (json) {
+            cout << "{\"scenario\":\"" << scenario
+                << "\",\"metric\":\"" << metric
+                << "\",\"value\":" << value
+                << ",\"unit\":\"" << unit << "\"}" << endl;
+        } else {
+            cout << scenario << " / " << metric << ": " << value << " " << unit << endl;
+        }
+    }
+
+    void FrameRecorder::Update(BenchHarness& harness)
+    {
+        size_t allocs = GetAllocationCount();
+        StopWatch watch;
+        harness.Update();
+        updateTime += watch.GetMilliseconds();
+        allocations += GetAllocationCount() - allocs;
+
+        const auto& stats = harness.GetPhysics().GetStepStats();
+        sum.bodyCount += stats.bodyCount;
+        sum.awakeBodyCount += stats.awakeBodyCount;
+        sum.contactCount += stats.contactCount;
+        sum.contactEventCount += stats.contactEventCount;
+        sum.numSteps += stats.numSteps;
+        sum.solver.level += stats.solver.level;
+        sum.spawnTime += stats.spawnTime;
+        sum.collectTime += stats.collectTime;
+        sum.stepTime += stats.stepTime;
+        sum.collideTime += stats.collideTime;
+        sum.solveTime += stats.solveTime;
+        sum.broadphaseTime += stats.broadphaseTime;
+        sum.solveTOITime += stats.solveTOITime;
+        sum.deployTime += stats.deployTime;
+        sum.dispatchTime += stats.dispatchTime;
+        ++numFrames;
+    }
+
+    void FrameRecorder::Report(BenchReport& report, const string& scenario) const
+    {
+        if (numFrames == 0) {
+            return;
+        }
+
+        const double n = numFrames;
+        report.Record(scenario, "frames", n, "count");
+        report.Record(scenario, "bodies", sum.bodyCount / n, "count");
+        report.Record(scenario, "awake_bodies", sum.awakeBodyCount / n, "count");
+        report.Record(scenario, "contacts", sum.contactCount / n, "count");
+        report.Record(scenario, "contact_events", sum.contactEventCount / n, "count");
+        report.Record(scenario, "solver_level", sum.solver.level / n, "level");
+        report.Record(scenario, "update_time", updateTime / n, "ms");
+        report.Record(scenario, "spawn_time", sum.spawnTime / n, "ms");
+        report.Record(scenario, "collect_time", sum.collectTime / n, "ms");
+        report.Record(scenario, "step_time", sum.stepTime / n, "ms");
+        report.Record(scenario, "collide_time", sum.collideTime / n, "ms");
+        report.Record(scenario, "solve_time", sum.solveTime / n, "ms");
+        report.Record(scenario, "broadphase_time", sum.broadphaseTime / n, "ms");
+        report.Record(scenario, "toi_time", sum.solveTOITime / n, "ms");
+        report.Record(scenario, "deploy_time", sum.deployTime / n, "ms");
+        report.Record(scenario, "dispatch_time", sum.dispatchTime / n, "ms");
+        report.Record(scenario, "allocations", allocations / n, "count/frame");
+    }
+
+    void RecordMemory(BenchReport& report, const string& scenario, Box2DPhysicsSystem& physics)
+    {
+        const auto memory = physics.GetMemoryReport();
+        report.Record(scenario, "memory_world", static_cast<double>(memory.world.bytes), "bytes");
+        report.Record(scenario, "memory_bodies", static_cast<double>(memory.bodies.bytes), "bytes");
+        report.Record(scenario, "memory_fixtures", static_cast<double>(memory.fixtures.bytes), "bytes");
+        report.Record(scenario, "memory_shapes", static_cast<double>(memory.shapes.bytes), "bytes");
+        report.Record(scenario, "memory_contacts", static_cast<double>(memory.contacts.bytes), "bytes");
+        report.Record(scenario, "memory_tree_nodes", static_cast<double>(memory.treeNodes.bytes), "bytes");
+        report.Record(scenario, "memory_allocator_slack", static_cast<double>(memory.allocatorSlack.bytes), "bytes");
+        report.Record(scenario, "memory_bindings", static_cast<double>(memory.bindings.bytes), "bytes");
+        report.Record(scenario, "memory_shape_cache", static_cast<double>(memory.shapeCache.bytes), "bytes");
+        report.Record(scenario, "memory_buffers", static_cast<double>(memory.buffers.bytes), "bytes");
+        report.Record(scenario, "memory_total", static_cast<double>(memory.totalBytes), "bytes");
+        report.Record(scenario, "memory_peak", static_cast<double>(memory.peakBytes), "bytes");
+    }
+
+} // end of namespace
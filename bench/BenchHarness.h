@@ -0,0 +1,252 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+#pragma once
+
+// Local includes
+#include "Box2DPhysicsSystem.h"
+
+// AST-Utilities includes
+#include <ECS/EntityService.h>
+
+// C++ Standard Library includes
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace astu::suite2d::bench {
+
+    /**
+     * Headless environment used to run the Box2D integration.
+     *
+     * Sets up the services required by the physics system and advances
+     * time in constant steps, which makes runs reproducible.
+     */
+    class BenchHarness {
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param dt    the elapsed time per update in seconds
+         */
+        explicit BenchHarness(double dt = 1.0 / 60.0);
+
+        /**
+         * Destructor, shuts down all services.
+         */
+        ~BenchHarness();
+
+        /**
+         * Returns the physics system under test.
+         *
+         * @return the physics system
+         */
+        Box2DPhysicsSystem& GetPhysics() {
+            return *physics;
+        }
+
+        /**
+         * Creates an entity with a circle collider.
+         *
+         * @param x         the x-coordinate of the center
+         * @param y         the y-coordinate of the center
+         * @param radius    the radius
+         * @param type      the body type
+         * @return the new entity, not yet added
+         */
+        std::shared_ptr<Entity> CreateCircle(float x, float y, float radius, CBody::Type type);
+
+        /**
+         * Creates an entity with a box shaped polygon collider.
+         *
+         * @param x     the x-coordinate of the center
+         * @param y     the y-coordinate of the center
+         * @param w     the width of the box
+         * @param h     the height of the box
+         * @param type  the body type
+         * @return the new entity, not yet added
+         */
+        std::shared_ptr<Entity> CreateBox(float x, float y, float w, float h, CBody::Type type);
+
+        /**
+         * Adds an entity to the entity service.
+         *
+         * @param entity    the entity to add
+         */
+        void Add(std::shared_ptr<Entity> entity);
+
+        /**
+         * Removes an entity from the entity service.
+         *
+         * @param entity    the entity to remove
+         */
+        void Remove(std::shared_ptr<Entity> entity);
+
+        /**
+         * Performs one update of all services.
+         */
+        void Update();
+
+    private:
+        /** The physics system under test. */
+        std::shared_ptr<Box2DPhysicsSystem> physics;
+
+        /** Used to manage entities. */
+        std::shared_ptr<EntityService> entities;
+
+        /** Used to update all services. */
+        std::shared_ptr<UpdateService> updater;
+    };
+
+    /**
+     * Collects measurements of benchmark scenarios.
+     *
+     * Results are printed human readable and, optionally, as JSON lines
+     * which can be compared between releases.
+     */
+    class BenchReport {
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param json  whether to emit JSON lines instead of plain text
+         */
+        explicit BenchReport(bool json) : json(json) {}
+
+        /**
+         * Records a measurement.
+         *
+         * @param scenario  the name of the scenario
+         * @param metric    the name of the metric
+         * @param value     the measured value
+         * @param unit      the unit of the measured value
+         */
+        void Record(const std::string& scenario, const std::string& metric, double value, const std::string& unit);
+
+    private:
+        /** Whether to emit JSON lines. */
+        bool json;
+    };
+
+    /**
+     * Returns the number of heap allocations performed so far.
+     *
+     * Counted by replacing the global allocation functions of the
+     * benchmark executable. Box2D allocates its memory by `b2Alloc`,
+     * hence only allocations of the integration and the ECS are counted.
+     *
+     * @return the number of allocations
+     */
+    size_t GetAllocationCount();
+
+    /**
+     * Accumulates per-update measurements of the physics system.
+     */
+    class FrameRecorder {
+    public:
+
+        /**
+         * Runs one update of the harness and records its measurements.
+         *
+         * @param harness   the harness to update
+         */
+        void Update(BenchHarness& harness);
+
+        /**
+         * Reports the averages of all recorded updates.
+         *
+         * @param report    receives the measurements
+         * @param scenario  the name of the scenario
+         */
+        void Report(BenchReport& report, const std::string& scenario) const;
+
+    private:
+        /** The number of recorded updates. */
+        int numFrames = 0;
+
+        /** The accumulated time of complete updates. */
+        double updateTime = 0;
+
+        /** The accumulated statistics of the physics system. */
+        StepStats sum;
+
+        /** The accumulated number of allocations. */
+        size_t allocations = 0;
+    };
+
+    /**
+     * Reports the memory footprint of a physics system.
+     *
+     * @param report    receives the measurements
+     * @param scenario  the name of the scenario
+     * @param physics   the physics system to report
+     */
+    void RecordMemory(BenchReport& report, const std::string& scenario, Box2DPhysicsSystem& physics);
+
+    /**
+     * Simple stop watch based on a steady clock.
+     */
+    class StopWatch {
+    public:
+
+        /** Constructor, starts the stop watch. */
+        StopWatch() : start(std::chrono::steady_clock::now()) {}
+
+        /** Restarts the stop watch. */
+        void Restart() {
+            start = std::chrono::steady_clock::now();
+        }
+
+        /**
+         * Returns the elapsed time since the last start.
+         *
+         * @return the elapsed time in milliseconds
+         */
+        double GetMilliseconds() const {
+            return std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count();
+        }
+
+    private:
+        /** The time the stop watch has been started. */
+        std::chrono::steady_clock::time_point start;
+    };
+
+    /** Runs the batched ray cast scenario. */
+    void RunRayCastBench(BenchReport& report);
+
+    /** Runs the bulk spawn and despawn scenario. */
+    void RunSpawnBench(BenchReport& report);
+
+    /** Runs the stacked pyramid scenario. */
+    void RunPyramidBench(BenchReport& report);
+
+    /** Runs the rain of circles scenario. */
+    void RunRainBench(BenchReport& report);
+
+    /** Runs the spawn and despawn churn scenario. */
+    void RunChurnBench(BenchReport& report);
+
+    /** Runs the mostly sleeping world scenario. */
+    void RunSleepingBench(BenchReport& report);
+
+    /** Runs the high contact density scenario. */
+    void RunContactsBench(BenchReport& report);
+
+    /** Runs the snapshot save and restore scenario. */
+    void RunSnapshotBench(BenchReport& report);
+
+    /** Runs the asynchronous step scenario against a synchronous baseline. */
+    void RunAsyncBench(BenchReport& report);
+
+    /** Runs the serial against parallel transform synchronization scenario. */
+    void RunSyncBench(BenchReport& report);
+
+} // end of namespace
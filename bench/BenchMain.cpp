@@ -0,0 +1,58 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "BenchHarness.h"
+
+// C++ Standard Library includes
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace astu::suite2d::bench;
+
+int main(int argc, char* argv[])
+{
+    const vector<pair<string, function<void(BenchReport&)>>> scenarios = {
+        {"raycast", RunRayCastBench},
+        {"spawn", RunSpawnBench},
+        {"pyramid", RunPyramidBench},
+        {"rain", RunRainBench},
+        {"churn", RunChurnBench},
+        {"sleeping", RunSleepingBench},
+        {"contacts", RunContactsBench},
+        {"snapshot", RunSnapshotBench},
+        {"async", RunAsyncBench},
+        {"sync", RunSyncBench},
+    };
+
+    bool json = false;
+    vector<string> selected;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else {
+            selected.push_back(argv[i]);
+        }
+    }
+
+    BenchReport report(json);
+    for (const auto& scenario : scenarios) {
+        if (selected.empty()
+            || find(selected.begin(), selected.end(), scenario.first) != selected.end())
+        {
+            scenario.second(report);
+        }
+    }
+
+    return 0;
+}
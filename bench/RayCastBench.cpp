@@ -0,0 +1,83 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "BenchHarness.h"
+
+// C++ Standard Library includes
+#include <algorithm>
+#include <random>
+#include <thread>
+
+using namespace std;
+
+namespace astu::suite2d::bench {
+
+    static const char* SCENARIO = "raycast";
+    static const int NUM_BODIES = 5000;
+    static const size_t NUM_RAYS = 100000;
+    static const int NUM_REPETITIONS = 10;
+    static const float WORLD_SIZE = 200.0f;
+
+    /**
+     * Measures the throughput of batched ray casts.
+     *
+     * @param physics   the physics system to query
+     * @param rays      the rays to cast
+     * @param hits      receives the hits
+     * @return the number of rays per second
+     */
+    static double MeasureRayCasts(Box2DPhysicsSystem& physics, const vector<RayCastQuery>& rays, vector<RayCastHit>& hits)
+    {
+        StopWatch watch;
+        for (int i = 0; i < NUM_REPETITIONS; ++i) {
+            physics.RayCast(rays.data(), hits.data(), rays.size());
+        }
+        return (rays.size() * NUM_REPETITIONS) / (watch.GetMilliseconds() / 1000.0);
+    }
+
+    void RunRayCastBench(BenchReport& report)
+    {
+        BenchHarness harness;
+        auto& physics = harness.GetPhysics();
+
+        mt19937 rng(42);
+        uniform_real_distribution<float> coord(-WORLD_SIZE / 2, WORLD_SIZE / 2);
+        uniform_real_distribution<float> size(0.25f, 1.5f);
+
+        for (int i = 0; i < NUM_BODIES; ++i) {
+            harness.Add(harness.CreateCircle(coord(rng), coord(rng), size(rng), CBody::Type::Static));
+        }
+        harness.Update();
+
+        vector<RayCastQuery> rays(NUM_RAYS);
+        for (auto& ray : rays) {
+            ray.from.Set(coord(rng), coord(rng));
+            ray.to.Set(coord(rng), coord(rng));
+        }
+        vector<RayCastHit> hits(NUM_RAYS);
+
+        unsigned int numThreads = max(1u, thread::hardware_concurrency());
+
+        physics.SetWorkerThreads(0);
+        double serial = MeasureRayCasts(physics, rays, hits);
+
+        physics.SetWorkerThreads(numThreads - 1);
+        double parallel = MeasureRayCasts(physics, rays, hits);
+
+        size_t numHits = count_if(hits.begin(), hits.end(),
+            [](const RayCastHit& hit) { return hit.entity != nullptr; });
+
+        report.Record(SCENARIO, "bodies", NUM_BODIES, "count");
+        report.Record(SCENARIO, "hits", static_cast<double>(numHits), "count");
+        report.Record(SCENARIO, "threads", numThreads, "count");
+        report.Record(SCENARIO, "serial_throughput", serial, "rays/s");
+        report.Record(SCENARIO, "parallel_throughput", parallel, "rays/s");
+        report.Record(SCENARIO, "speedup", parallel / serial, "x");
+    }
+
+} // end of namespace
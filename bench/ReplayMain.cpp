@@ -0,0 +1,53 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "Box2DReplay.h"
+
+// C++ Standard Library includes
+#include <cstring>
+#include <exception>
+#include <iostream>
+
+using namespace std;
+using namespace astu::suite2d;
+
+int main(int argc, char* argv[])
+{
+    const char* filename = nullptr;
+    bool stopOnDivergence = true;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--all") == 0) {
+            stopOnDivergence = false;
+        } else {
+            filename = argv[i];
+        }
+    }
+
+    if (!filename) {
+        cerr << "usage: astu_box2d_replay [--all] <recording>" << endl;
+        return 2;
+    }
+
+    try {
+        Box2DReplayer replayer(filename);
+        ReplayResult result = replayer.Run(stopOnDivergence);
+        cout << "replayed " << result.numSteps << " steps" << endl;
+        if (result.diverged) {
+            cout << "diverged at step " << result.divergingStep
+                << hex << ", recorded hash 0x" << result.recordedHash
+                << ", replayed hash 0x" << result.replayedHash << dec << endl;
+            return 1;
+        }
+        cout << "no divergence" << endl;
+    } catch (const exception& e) {
+        cerr << e.what() << endl;
+        return 2;
+    }
+
+    return 0;
+}
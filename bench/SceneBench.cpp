@@ -0,0 +1,195 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "BenchHarness.h"
+#include "CBox2DBody.h"
+
+// C++ Standard Library includes
+#include <deque>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+namespace astu::suite2d::bench {
+
+    static const int NUM_WARMUP_FRAMES = 60;
+    static const int NUM_FRAMES = 600;
+    static const float GRAVITY = -10.0f;
+
+    /**
+     * Adds static walls enclosing an area.
+     *
+     * @param harness   the harness to add the walls to
+     * @param w         the width of the enclosed area
+     * @param h         the height of the enclosed area
+     */
+    static void AddWalls(BenchHarness& harness, float w, float h)
+    {
+        harness.Add(harness.CreateBox(0, -0.5f, w + 2, 1, CBody::Type::Static));
+        harness.Add(harness.CreateBox(-w / 2 - 0.5f, h / 2, 1, h, CBody::Type::Static));
+        harness.Add(harness.CreateBox(w / 2 + 0.5f, h / 2, 1, h, CBody::Type::Static));
+    }
+
+    void RunPyramidBench(BenchReport& report)
+    {
+        static const int BASE = 40;
+
+        BenchHarness harness;
+        harness.GetPhysics().SetGravityVector(0, GRAVITY);
+        harness.Add(harness.CreateBox(0, -0.5f, 200, 1, CBody::Type::Static));
+
+        for (int row = 0; row < BASE; ++row) {
+            int n = BASE - row;
+            float x0 = -0.5f * (n - 1);
+            for (int i = 0; i < n; ++i) {
+                harness.Add(harness.CreateBox(x0 + i, 0.5f + row, 1, 1, CBody::Type::Dynamic));
+            }
+        }
+
+        FrameRecorder recorder;
+        for (int i = 0; i < NUM_FRAMES; ++i) {
+            recorder.Update(harness);
+        }
+        recorder.Report(report, "pyramid");
+        RecordMemory(report, "pyramid", harness.GetPhysics());
+    }
+
+    void RunRainBench(BenchReport& report)
+    {
+        static const int DROPS_PER_FRAME = 10;
+        static const float WIDTH = 100.0f;
+        static const float HEIGHT = 60.0f;
+
+        BenchHarness harness;
+        harness.GetPhysics().SetGravityVector(0, GRAVITY);
+        AddWalls(harness, WIDTH, HEIGHT);
+
+        mt19937 rng(42);
+        uniform_real_distribution<float> coord(-WIDTH / 2 + 1, WIDTH / 2 - 1);
+        uniform_real_distribution<float> size(0.1f, 0.4f);
+
+        FrameRecorder recorder;
+        for (int i = 0; i < NUM_FRAMES; ++i) {
+            for (int j = 0; j < DROPS_PER_FRAME; ++j) {
+                harness.Add(harness.CreateCircle(coord(rng), HEIGHT, size(rng), CBody::Type::Dynamic));
+            }
+            recorder.Update(harness);
+        }
+        recorder.Report(report, "rain");
+        RecordMemory(report, "rain", harness.GetPhysics());
+    }
+
+    void RunChurnBench(BenchReport& report)
+    {
+        static const int NUM_ENTITIES = 2000;
+        static const int CHURN_PER_FRAME = 100;
+        static const float WIDTH = 200.0f;
+
+        BenchHarness harness;
+        harness.GetPhysics().SetGravityVector(0, GRAVITY);
+        harness.GetPhysics().SetDeferredSpawning(true);
+        AddWalls(harness, WIDTH, 40);
+
+        mt19937 rng(42);
+        uniform_real_distribution<float> coord(-WIDTH / 2 + 1, WIDTH / 2 - 1);
+        uniform_real_distribution<float> height(1, 40);
+
+        deque<shared_ptr<Entity>> alive;
+        auto spawn = [&]() {
+            alive.push_back(harness.CreateCircle(coord(rng), height(rng), 0.5f, CBody::Type::Dynamic));
+            harness.Add(alive.back());
+        };
+
+        for (int i = 0; i < NUM_ENTITIES; ++i) {
+            spawn();
+        }
+        for (int i = 0; i < NUM_WARMUP_FRAMES; ++i) {
+            harness.Update();
+        }
+
+        FrameRecorder recorder;
+        for (int i = 0; i < NUM_FRAMES; ++i) {
+            for (int j = 0; j < CHURN_PER_FRAME; ++j) {
+                harness.Remove(alive.front());
+                alive.pop_front();
+                spawn();
+            }
+            recorder.Update(harness);
+        }
+        recorder.Report(report, "churn");
+        RecordMemory(report, "churn", harness.GetPhysics());
+    }
+
+    void RunSleepingBench(BenchReport& report)
+    {
+        static const int NUM_SLEEPING = 10000;
+        static const int NUM_AWAKE = 50;
+        static const int NUM_SETTLE_FRAMES = 300;
+
+        BenchHarness harness;
+        harness.GetPhysics().SetGravityVector(0, GRAVITY);
+        harness.Add(harness.CreateBox(0, -0.5f, 4 * NUM_SLEEPING, 1, CBody::Type::Static));
+
+        // Bodies resting on the ground, spaced apart and soon asleep.
+        for (int i = 0; i < NUM_SLEEPING; ++i) {
+            harness.Add(harness.CreateBox(2.0f * (i - NUM_SLEEPING / 2), 0.5f, 1, 1, CBody::Type::Dynamic));
+        }
+        for (int i = 0; i < NUM_SETTLE_FRAMES; ++i) {
+            harness.Update();
+        }
+
+        // A few bodies kept awake by moving them around.
+        vector<CBox2DBody*> awake;
+        for (int i = 0; i < NUM_AWAKE; ++i) {
+            auto entity = harness.CreateCircle(2.0f * i, 20, 0.5f, CBody::Type::Kinematic);
+            harness.Add(entity);
+            awake.push_back(&entity->GetComponent<CBox2DBody>());
+        }
+
+        FrameRecorder recorder;
+        for (int i = 0; i < NUM_FRAMES; ++i) {
+            float v = (i / 60) % 2 ? 1.0f : -1.0f;
+            for (auto& body : awake) {
+                body->SetLinearVelocity(v, 0);
+            }
+            recorder.Update(harness);
+        }
+        recorder.Report(report, "sleeping");
+        RecordMemory(report, "sleeping", harness.GetPhysics());
+    }
+
+    void RunContactsBench(BenchReport& report)
+    {
+        static const int COLUMNS = 60;
+        static const int ROWS = 60;
+
+        BenchHarness harness;
+        harness.GetPhysics().SetGravityVector(0, GRAVITY);
+        AddWalls(harness, COLUMNS, ROWS * 2);
+
+        // Circles packed tightly into a container.
+        for (int row = 0; row < ROWS; ++row) {
+            for (int col = 0; col < COLUMNS; ++col) {
+                float x = -COLUMNS / 2.0f + 0.5f + col + (row % 2) * 0.25f;
+                harness.Add(harness.CreateCircle(x, 0.5f + row * 0.9f, 0.5f, CBody::Type::Dynamic));
+            }
+        }
+        for (int i = 0; i < NUM_WARMUP_FRAMES; ++i) {
+            harness.Update();
+        }
+
+        FrameRecorder recorder;
+        for (int i = 0; i < NUM_FRAMES; ++i) {
+            recorder.Update(harness);
+        }
+        recorder.Report(report, "contacts");
+        RecordMemory(report, "contacts", harness.GetPhysics());
+    }
+
+} // end of namespace
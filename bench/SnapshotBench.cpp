@@ -0,0 +1,67 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "BenchHarness.h"
+
+using namespace std;
+
+namespace astu::suite2d::bench {
+
+    static const char* SCENARIO = "snapshot";
+    static const int COLUMNS = 100;
+    static const int ROWS = 100;
+    static const int NUM_SETTLE_FRAMES = 120;
+    static const int NUM_REPETITIONS = 100;
+
+    void RunSnapshotBench(BenchReport& report)
+    {
+        BenchHarness harness;
+        auto& physics = harness.GetPhysics();
+        physics.SetGravityVector(0, -10);
+        harness.Add(harness.CreateBox(0, -0.5f, 2.0f * COLUMNS, 1, CBody::Type::Static));
+
+        // Stacked circles, which results in plenty of touching contacts.
+        for (int row = 0; row < ROWS; ++row) {
+            for (int col = 0; col < COLUMNS; ++col) {
+                float x = -COLUMNS / 2.0f + col + (row % 2) * 0.5f;
+                harness.Add(harness.CreateCircle(x, 0.5f + row, 0.5f, CBody::Type::Dynamic));
+            }
+        }
+        for (int i = 0; i < NUM_SETTLE_FRAMES; ++i) {
+            harness.Update();
+        }
+
+        PhysicsSnapshot snapshot;
+        physics.SaveSnapshot(snapshot);
+
+        StopWatch watch;
+        for (int i = 0; i < NUM_REPETITIONS; ++i) {
+            physics.SaveSnapshot(snapshot);
+        }
+        double saveTime = watch.GetMilliseconds() / NUM_REPETITIONS;
+
+        // Advance the simulation before each rollback, otherwise bodies are
+        // already in place from the second rollback on. Only the rollback
+        // is timed.
+        double restoreTime = 0;
+        for (int i = 0; i < NUM_REPETITIONS; ++i) {
+            harness.Update();
+            watch.Restart();
+            physics.RestoreSnapshot(snapshot);
+            restoreTime += watch.GetMilliseconds();
+        }
+        restoreTime /= NUM_REPETITIONS;
+
+        report.Record(SCENARIO, "bodies", COLUMNS * ROWS, "count");
+        report.Record(SCENARIO, "contacts", physics.GetStepStats().contactCount, "count");
+        report.Record(SCENARIO, "size", static_cast<double>(snapshot.Size()), "bytes");
+        report.Record(SCENARIO, "save_time", saveTime, "ms");
+        report.Record(SCENARIO, "restore_time", restoreTime, "ms");
+    }
+
+} // end of namespace
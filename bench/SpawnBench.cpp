@@ -0,0 +1,75 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "BenchHarness.h"
+
+// C++ Standard Library includes
+#include <random>
+#include <string>
+
+using namespace std;
+
+namespace astu::suite2d::bench {
+
+    static const char* SCENARIO = "spawn";
+    static const int NUM_ENTITIES = 10000;
+    static const float WORLD_SIZE = 400.0f;
+
+    /**
+     * Measures spawning and despawning of entities within one frame.
+     *
+     * @param report    receives the measurements
+     * @param deferred  whether to use deferred spawning
+     */
+    static void MeasureSpawn(BenchReport& report, bool deferred)
+    {
+        BenchHarness harness;
+        auto& physics = harness.GetPhysics();
+        physics.SetDeferredSpawning(deferred);
+        if (deferred) {
+            physics.ReserveBodies(NUM_ENTITIES);
+        }
+
+        mt19937 rng(42);
+        uniform_real_distribution<float> coord(-WORLD_SIZE / 2, WORLD_SIZE / 2);
+
+        vector<shared_ptr<Entity>> entities;
+        entities.reserve(NUM_ENTITIES);
+        for (int i = 0; i < NUM_ENTITIES; ++i) {
+            entities.push_back(harness.CreateCircle(coord(rng), coord(rng), 0.5f, CBody::Type::Dynamic));
+        }
+
+        StopWatch watch;
+        for (auto& entity : entities) {
+            harness.Add(entity);
+        }
+        harness.Update();
+        double spawnTime = watch.GetMilliseconds();
+
+        watch.Restart();
+        for (auto& entity : entities) {
+            harness.Remove(entity);
+        }
+        harness.Update();
+        double despawnTime = watch.GetMilliseconds();
+
+        const string prefix = deferred ? "deferred_" : "immediate_";
+        report.Record(SCENARIO, prefix + "spawn_time", spawnTime, "ms");
+        report.Record(SCENARIO, prefix + "spawn_throughput", NUM_ENTITIES / (spawnTime / 1000.0), "entities/s");
+        report.Record(SCENARIO, prefix + "despawn_time", despawnTime, "ms");
+        report.Record(SCENARIO, prefix + "despawn_throughput", NUM_ENTITIES / (despawnTime / 1000.0), "entities/s");
+    }
+
+    void RunSpawnBench(BenchReport& report)
+    {
+        report.Record(SCENARIO, "entities", NUM_ENTITIES, "count");
+        MeasureSpawn(report, false);
+        MeasureSpawn(report, true);
+    }
+
+} // end of namespace
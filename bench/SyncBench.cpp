@@ -0,0 +1,115 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "BenchHarness.h"
+#include "CBox2DBody.h"
+
+// C++ Standard Library includes
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+namespace astu::suite2d::bench {
+
+    static const char* SCENARIO = "sync";
+    static const int BODY_COUNTS[] = {1000, 2500, 5000, 10000, 25000, 50000};
+    static const int NUM_WARMUP_FRAMES = 10;
+    static const int NUM_FRAMES = 100;
+    static const int GRAIN_BODIES = 50000;
+    static const size_t GRAINS[] = {256, 1024, 4096, 16384};
+
+    /**
+     * Measures the time spent synchronizing transforms.
+     *
+     * @param harness   the harness to update
+     * @return the average collect and deploy time per update in milliseconds
+     */
+    static double MeasureSyncTime(BenchHarness& harness)
+    {
+        for (int i = 0; i < NUM_WARMUP_FRAMES; ++i) {
+            harness.Update();
+        }
+
+        double syncTime = 0;
+        for (int i = 0; i < NUM_FRAMES; ++i) {
+            harness.Update();
+            const auto& stats = harness.GetPhysics().GetStepStats();
+            syncTime += stats.collectTime + stats.deployTime;
+        }
+        return syncTime / NUM_FRAMES;
+    }
+
+    /**
+     * Adds moving kinematic bodies arranged in a grid.
+     *
+     * Moving kinematic bodies stay awake without any contacts, hence each
+     * update deploys all transforms.
+     *
+     * @param harness   the harness to add the bodies to
+     * @param numBodies the number of bodies
+     */
+    static void AddMovingBodies(BenchHarness& harness, int numBodies)
+    {
+        const int columns = static_cast<int>(sqrt(numBodies));
+        for (int i = 0; i < numBodies; ++i) {
+            auto entity = harness.CreateCircle(2.0f * (i % columns), 2.0f * (i / columns),
+                0.5f, CBody::Type::Kinematic);
+            harness.Add(entity);
+            entity->GetComponent<CBox2DBody>().SetLinearVelocity(1.0f, 0.5f);
+        }
+    }
+
+    void RunSyncBench(BenchReport& report)
+    {
+        unsigned int numThreads = max(1u, thread::hardware_concurrency());
+        report.Record(SCENARIO, "threads", numThreads, "count");
+
+        int crossover = 0;
+        for (int numBodies : BODY_COUNTS) {
+            BenchHarness harness;
+            auto& physics = harness.GetPhysics();
+            physics.SetWorkerThreads(numThreads - 1);
+            AddMovingBodies(harness, numBodies);
+
+            physics.SetParallelSyncThreshold(numeric_limits<size_t>::max());
+            double serial = MeasureSyncTime(harness);
+
+            physics.SetParallelSyncThreshold(0);
+            double parallel = MeasureSyncTime(harness);
+
+            if (!crossover && parallel < serial) {
+                crossover = numBodies;
+            }
+
+            const string suffix = "_" + to_string(numBodies);
+            report.Record(SCENARIO, "serial_sync_time" + suffix, serial, "ms");
+            report.Record(SCENARIO, "parallel_sync_time" + suffix, parallel, "ms");
+            report.Record(SCENARIO, "speedup" + suffix, serial / parallel, "x");
+        }
+
+        // The smallest measured body count from which on parallel sync pays off.
+        report.Record(SCENARIO, "crossover", crossover, "bodies");
+
+        // Chunk sizes around the default, measured with the largest scene.
+        BenchHarness harness;
+        auto& physics = harness.GetPhysics();
+        physics.SetWorkerThreads(numThreads - 1);
+        physics.SetParallelSyncThreshold(0);
+        AddMovingBodies(harness, GRAIN_BODIES);
+
+        for (size_t grain : GRAINS) {
+            physics.SetParallelSyncGrain(grain);
+            report.Record(SCENARIO, "grain_sync_time_" + to_string(grain), MeasureSyncTime(harness), "ms");
+        }
+    }
+
+} // end of namespace
@@ -7,3 +7,15 @@
 
 #include "Box2DPhysicsSystem.h"
 #include "CBox2DBody.h"
+#include "CBox2DColliders.h"
+#include "CChainColliders.h"
+#include "CCompoundCollider.h"
+#include "Box2DContactEvents.h"
+#include "Box2DQueries.h"
+#include "Box2DStepStats.h"
+#include "Box2DSnapshot.h"
+#include "Box2DRegions.h"
+#include "Box2DMemory.h"
+#include "Box2DSolverBudget.h"
+#include "Box2DWorldGroup.h"
+#include "Box2DReplay.h"
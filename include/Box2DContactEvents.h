@@ -0,0 +1,156 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+#pragma once
+
+// AST-Utilities includes
+#include <Suite2D/CColliders.h>
+
+// C++ Standard Library includes
+#include <cstdint>
+
+namespace astu {
+
+    // Forward declaration
+    class Entity;
+
+}
+
+namespace astu::suite2d {
+
+    /**
+     * Describes a contact which began or ended touching during a step.
+     *
+     * The entity and collider pointers are not owning and remain valid
+     * until the next update of the physics system, unless the entity gets
+     * removed before.
+     */
+    struct ContactEvent {
+
+        /** The types of contact events. */
+        enum class Type : uint8_t {
+            /** Two colliders began touching. */
+            Begin,
+
+            /** Two colliders stopped touching. */
+            End,
+        };
+
+        /** The type of this event. */
+        Type type;
+
+        /** The child index of collider A, used by chain colliders. */
+        int32_t childIndexA;
+
+        /** The child index of collider B, used by chain colliders. */
+        int32_t childIndexB;
+
+        /** The first entity involved. */
+        Entity* entityA;
+
+        /** The second entity involved. */
+        Entity* entityB;
+
+        /** The collider of the first entity. */
+        CBodyCollider* colliderA;
+
+        /** The collider of the second entity. */
+        CBodyCollider* colliderB;
+
+        /** The sub-collider of the first entity, equals collider A unless it is a compound. */
+        CBodyCollider* subColliderA;
+
+        /** The sub-collider of the second entity, equals collider B unless it is a compound. */
+        CBodyCollider* subColliderB;
+
+        /** The contact normal in world coordinates, pointing from A to B. */
+        Vector2f normal;
+
+        /** The contact point in world coordinates. */
+        Vector2f point;
+    };
+
+    /**
+     * Describes a collision which exceeded the impact threshold.
+     *
+     * The entity and collider pointers are not owning and remain valid
+     * until the next update of the physics system, unless the entity gets
+     * removed before.
+     */
+    struct ImpactEvent {
+
+        /** The child index of collider A, used by chain colliders. */
+        int32_t childIndexA;
+
+        /** The child index of collider B, used by chain colliders. */
+        int32_t childIndexB;
+
+        /** The first entity involved. */
+        Entity* entityA;
+
+        /** The second entity involved. */
+        Entity* entityB;
+
+        /** The collider of the first entity. */
+        CBodyCollider* colliderA;
+
+        /** The collider of the second entity. */
+        CBodyCollider* colliderB;
+
+        /** The sub-collider of the first entity, equals collider A unless it is a compound. */
+        CBodyCollider* subColliderA;
+
+        /** The sub-collider of the second entity, equals collider B unless it is a compound. */
+        CBodyCollider* subColliderB;
+
+        /** The maximum normal impulse of all contact points. */
+        float normalImpulse;
+
+        /** The maximum absolute tangent impulse of all contact points. */
+        float tangentImpulse;
+
+        /** The contact normal in world coordinates, pointing from A to B. */
+        Vector2f normal;
+
+        /** The contact point with the maximum normal impulse. */
+        Vector2f point;
+    };
+
+    /**
+     * Describes an entity entering or leaving a sensor collider.
+     *
+     * Derived from the begin and end contacts of sensor colliders, an
+     * entity touching several fixtures of a sensor enters once and leaves
+     * once it touches none of them. The entity and collider pointers are
+     * not owning and remain valid until the next update of the physics
+     * system, unless the entity gets removed before.
+     */
+    struct SensorEvent {
+
+        /** The types of sensor events. */
+        enum class Type : uint8_t {
+            /** An entity entered the sensor. */
+            Enter,
+
+            /** An entity left the sensor. */
+            Exit,
+        };
+
+        /** The type of this event. */
+        Type type;
+
+        /** The entity owning the sensor. */
+        Entity* sensorEntity;
+
+        /** The sensor collider, a sub-collider in case of compound colliders. */
+        CBodyCollider* sensor;
+
+        /** The entity which entered or left the sensor. */
+        Entity* entity;
+    };
+
+} // end of namespace
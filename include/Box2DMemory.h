@@ -0,0 +1,98 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+#pragma once
+
+// C++ Standard Library includes
+#include <cstddef>
+
+namespace astu::suite2d {
+
+    /**
+     * The expected size of a physics world.
+     *
+     * Memory for the specified number of objects is allocated each time
+     * the world is created, hence a world which stays within its capacity
+     * does not allocate memory for Box2D objects during gameplay.
+     */
+    struct WorldCapacity {
+
+        /** The number of bodies. */
+        size_t bodies = 0;
+
+        /** The number of fixtures, i.e., colliders and their segments. */
+        size_t fixtures = 0;
+
+        /** The number of simultaneous contacts. */
+        size_t contacts = 0;
+    };
+
+    /**
+     * The memory used by objects of one category.
+     */
+    struct MemoryUsage {
+
+        /** The number of objects. */
+        size_t count = 0;
+
+        /** The number of bytes. */
+        size_t bytes = 0;
+    };
+
+    /**
+     * The memory footprint of a physics system.
+     *
+     * Box2D does not expose its allocators, hence the memory of Box2D
+     * objects is estimated from object counts and type sizes, rounded up
+     * to the block sizes of the Box2D block allocator. The memory of the
+     * integration is computed from the capacities of its buffers.
+     */
+    struct MemoryReport {
+
+        /** The world itself, including its stack allocator. */
+        MemoryUsage world;
+
+        /** The bodies. */
+        MemoryUsage bodies;
+
+        /** The fixtures, including their broad-phase proxies. */
+        MemoryUsage fixtures;
+
+        /** The shapes of fixtures, including the vertices of chains. */
+        MemoryUsage shapes;
+
+        /** The contacts between fixtures. */
+        MemoryUsage contacts;
+
+        /** The nodes of the broad-phase tree, bytes include unused nodes. */
+        MemoryUsage treeNodes;
+
+        /**
+         * The memory kept by the block allocator for reuse.
+         *
+         * Estimated from the peak usage observed since the world has
+         * been created, including its reserved capacity.
+         */
+        MemoryUsage allocatorSlack;
+
+        /** The binding table and the lists of pending spawns and despawns. */
+        MemoryUsage bindings;
+
+        /** The cooked shapes of polygon colliders. */
+        MemoryUsage shapeCache;
+
+        /** The event and command buffers. */
+        MemoryUsage buffers;
+
+        /** The sum of all categories in bytes. */
+        size_t totalBytes = 0;
+
+        /** The highest total of all reports since startup in bytes. */
+        size_t peakBytes = 0;
+    };
+
+} // end of namespace
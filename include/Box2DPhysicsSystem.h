@@ -17,18 +17,52 @@
 #include <Suite2D/CColliders.h>
 #include <Suite2D/CollisionSignal.h>
 
+// Local includes
+#include "Box2DContactEvents.h"
+#include "Box2DQueries.h"
+#include "Box2DStepStats.h"
+#include "Box2DSnapshot.h"
+#include "Box2DRegions.h"
+#include "Box2DMemory.h"
+#include "CChainColliders.h"
+#include "CCompoundCollider.h"
 
 // C++ Standard Library includes.
+#include <functional>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
  // forward declaration
 class b2World;
 class b2Body;
+class b2Contact;
+class b2Fixture;
+class b2Shape;
+struct b2ContactImpulse;
+struct b2Transform;
 
 namespace astu::suite2d {
 
     // Forward declaration
     class ContactListener;
+    class CBox2DBody;
+    class BindingTable;
+    class WorkerPool;
+    class Box2DWorldGroup;
+    class ShapeCache;
+    class Profiler;
+    class StepRecorder;
+    class AsyncStepper;
+    class SolverController;
+    class CommandQueue;
+    struct CommandBuffer;
+    struct ColliderCommand;
+    class ColliderChanges;
+    struct SensorContact;
+    class IBox2DCollider;
 
     class Box2DPhysicsSystem 
         : public BaseService
@@ -40,6 +74,9 @@ namespace astu::suite2d {
         , public CBodyFactory
         , public CCircleColliderFactory
         , public CPolygonColliderFactory
+        , public CChainColliderFactory
+        , public CEdgeColliderFactory
+        , public CCompoundColliderFactory
     {
     public:
 
@@ -89,6 +126,1029 @@ namespace astu::suite2d {
             return velocityIterations;
         }
 
+        /**
+         * Enables or disables fixed-timestep simulation.
+         *
+         * If enabled, the elapsed frame time is accumulated and the world is
+         * advanced in steps of constant size. Otherwise the world is
+         * advanced by the elapsed frame time once per update.
+         *
+         * @param b `true` to enable fixed-timestep simulation
+         * @return reference to this system for method chaining
+         */
+        Box2DPhysicsSystem& SetFixedTimeStep(bool b);
+
+        /**
+         * Returns whether fixed-timestep simulation is enabled.
+         *
+         * @return `true` if fixed-timestep simulation is enabled
+         */
+        bool IsFixedTimeStep() const {
+            return fixedTimeStep;
+        }
+
+        /**
+         * Sets the step size used for fixed-timestep simulation.
+         *
+         * @param dt    the step size in seconds
+         * @return reference to this system for method chaining
+         */
+        Box2DPhysicsSystem& SetStepSize(float dt);
+
+        /**
+         * Returns the step size used for fixed-timestep simulation.
+         *
+         * @return the step size in seconds
+         */
+        float GetStepSize() const {
+            return stepSize;
+        }
+
+        /**
+         * Sets the maximum number of steps performed within one update.
+         *
+         * Accumulated time exceeding this number of steps gets discarded.
+         *
+         * @param n the maximum number of sub-steps
+         * @return reference to this system for method chaining
+         */
+        Box2DPhysicsSystem& SetMaxSubSteps(int n);
+
+        /**
+         * Returns the maximum number of steps performed within one update.
+         *
+         * @return the maximum number of sub-steps
+         */
+        int GetMaxSubSteps() const {
+            return maxSubSteps;
+        }
+
+        /**
+         * Enables or disables pose interpolation.
+         *
+         * If enabled, the poses of moving bodies are interpolated between
+         * the previous and the current step according to the remaining
+         * accumulated time. Only used for fixed-timestep simulation.
+         *
+         * @param b `true` to enable pose interpolation
+         * @return reference to this system for method chaining
+         */
+        Box2DPhysicsSystem& SetInterpolation(bool b);
+
+        /**
+         * Returns whether pose interpolation is enabled.
+         *
+         * @return `true` if pose interpolation is enabled
+         */
+        bool IsInterpolation() const {
+            return interpolation;
+        }
+
+        /**
+         * Enables or disables continuous collision of dynamic bodies.
+         *
+         * Continuous collision prevents fast bodies from tunneling through
+         * static bodies and bullets from tunneling through dynamic bodies.
+         *
+         * @param b `true` to enable continuous collision
+         * @return reference to this system for method chaining
+         */
+        Box2DPhysicsSystem& SetContinuousPhysics(bool b);
+
+        /**
+         * Returns whether continuous collision is enabled.
+         *
+         * @return `true` if continuous collision is enabled
+         */
+        bool IsContinuousPhysics() const {
+            return continuousPhysics;
+        }
+
+        /**
+         * Enables or disables the adaptive solver.
+         *
+         * The adaptive solver measures the time of each step and lowers
+         * solver iterations, continuous collision and sub-steps while the
+         * steps exceed the time budget. The quality is raised again once
+         * the steps stay clearly below the budget. The configured
+         * iterations, continuous collision and maximum number of sub-steps
+         * are the highest quality.
+         *
+         * @param b `true` to enable the adaptive solver
+         * @return reference to this system for method chaining
+         */
+        Box2DPhysicsSystem& SetAdaptiveSolver(bool b);
+
+        /**
+         * Returns whether the adaptive solver is enabled.
+         *
+         * @return `true` if the adaptive solver is enabled
+         */
+        bool IsAdaptiveSolver() const {
+            return solverController != nullptr;
+        }
+
+        /**
+         * Sets the time budget and the lower quality bounds of the adaptive solver.
+         *
+         * Restarts the adaptive solver at the highest quality.
+         *
+         * @param budget    the solver budget
+         * @return reference to this system for method chaining
+         * @throws std::logic_error in case the budget is invalid
+         */
+        Box2DPhysicsSystem& SetSolverBudget(const SolverBudget& budget);
+
+        /**
+         * Returns the time budget and the lower quality bounds of the adaptive solver.
+         *
+         * @return the solver budget
+         */
+        const SolverBudget& GetSolverBudget() const {
+            return solverBudget;
+        }
+
+        /**
+         * Returns the solver settings used for the last step.
+         *
+         * @return the solver settings
+         */
+        const SolverLevel& GetSolverLevel() const {
+            return GetStepStats().solver;
+        }
+
+        /**
+         * Specifies whether to push the poses of all non-static bodies.
+         *
+         * By default, only poses which have been changed outside this system
+         * since the last update are transferred to Box2D. If enabled, the
+         * poses of all dynamic and kinematic bodies are transferred each
+         * update, which is the behavior of earlier versions. Kinematic bodies
+         * are considered to be driven by their poses in this mode and their
+         * poses are not updated by this system.
+         *
+         * @param b `true` to push the poses of all non-static bodies
+         * @return reference to this system for method chaining
+         */
+        Box2DPhysicsSystem& SetAlwaysPushPoses(bool b);
+
+        /**
+         * Returns whether the poses of all non-static bodies are pushed.
+         *
+         * @return `true` if the poses of all non-static bodies are pushed
+         */
+        bool IsAlwaysPushPoses() const {
+            return alwaysPushPoses;
+        }
+
+        /**
+         * Enables or disables deferred creation and destruction of bodies.
+         *
+         * If enabled, bodies of entities added to or removed from the
+         * entity system are created or destroyed at the beginning of the
+         * next update. Only the handling of entity events is batched:
+         * the binding table is reserved once for all pending entities and
+         * entities removed before their bodies have been created are
+         * dropped. Box2D has no bulk interface, the bodies and fixtures
+         * are still created and destroyed one by one. Entities removed
+         * remain alive until their bodies are destroyed. Disabling
+         * deferred spawning processes all pending entities.
+         *
+         * @param b `true` to defer creation and destruction of bodies
+         * @return reference to this system for method chaining
+         */
+        Box2DPhysicsSystem& SetDeferredSpawning(bool b);
+
+        /**
+         * Returns whether creation and destruction of bodies is deferred.
+         *
+         * @return `true` if creation and destruction of bodies is deferred
+         */
+        bool IsDeferredSpawning() const {
+            return deferredSpawning;
+        }
+
+        /**
+         * Returns the number of entities waiting for their bodies.
+         *
+         * @return the number of pending entities
+         */
+        size_t NumPendingSpawns() const {
+            return pendingSpawns.size();
+        }
+
+        /**
+         * Enables or disables deferred commands.
+         *
+         * If enabled, changes of bodies and colliders, e.g., velocities,
+         * forces, materials and filters, are not pushed to Box2D
+         * immediately. Each thread lists the changed bodies and colliders
+         * in a buffer of its own, hence changes can be issued by parallel
+         * jobs, as long as each body or collider is changed by one thread
+         * at a time. Repeated changes collapse into one, forces and
+         * torques accumulate. The changes are applied in bulk at the
+         * beginning of the next update and must not be issued while the
+         * physics system is updated.
+         *
+         * Until then, getters which read the state of Box2D, e.g., the
+         * velocities of bodies, return the state before the changes.
+         * Properties stored by the components themselves, e.g., collider
+         * materials, return the changed values.
+         *
+         * Disabling deferred commands applies pending changes.
+         *
+         * @param b `true` to defer commands
+         * @return reference to this system for method chaining
+         */
+        Box2DPhysicsSystem& SetDeferredCommands(bool b);
+
+        /**
+         * Returns whether changes of bodies and colliders are deferred.
+         *
+         * @return `true` if commands are deferred
+         */
+        bool IsDeferredCommands() const {
+            return deferredCommands;
+        }
+
+        /**
+         * Reserves memory for the specified number of bodies.
+         *
+         * @param n the number of bodies
+         * @return reference to this system for method chaining
+         */
+        Box2DPhysicsSystem& ReserveBodies(size_t n);
+
+        /**
+         * Reserves memory for the expected size of the physics world.
+         *
+         * Box2D keeps the memory of destroyed bodies, fixtures, contacts
+         * and broad-phase nodes for reuse until the world is destroyed.
+         * The capacity is therefore allocated in advance by creating and
+         * destroying placeholder objects each time the world is created.
+         * Memory for contacts can only be reserved while the world holds
+         * no bodies, e.g., before entities are added or after the world
+         * has been cleared.
+         *
+         * Reserving takes time proportional to the capacity: placeholder
+         * bodies and fixtures are created, a step of zero length creates
+         * the reserved contacts, and everything is destroyed again. This
+         * cost recurs each time the world is created, e.g., by ClearWorld.
+         *
+         * @param capacity  the capacity of the world
+         * @return reference to this system for method chaining
+         */
+        Box2DPhysicsSystem& ReserveCapacity(const WorldCapacity& capacity);
+
+        /**
+         * Returns the reserved capacity of the physics world.
+         *
+         * @return the capacity of the world
+         */
+        const WorldCapacity& GetCapacity() const {
+            return capacity;
+        }
+
+        /**
+         * Drops all bodies at once.
+         *
+         * Rather than destroying bodies one by one, which removes their
+         * contacts and broad-phase proxies individually, the world is
+         * discarded as a whole and replaced by an empty world of the
+         * reserved capacity. Pending spawns are dropped as well and no
+         * contact events are reported for the dropped bodies.
+         *
+         * Entities remaining in the entity service keep their components
+         * without bodies, they have to be removed and added again to
+         * obtain new bodies.
+         *
+         * The time spent does not depend on the number of dropped bodies
+         * but on the reserved capacity, since the new world reserves its
+         * capacity again, see ReserveCapacity. With a large capacity and
+         * few bodies, destroying the bodies one by one can be faster.
+         */
+        void ClearWorld();
+
+        /**
+         * Returns the memory footprint of this physics system.
+         *
+         * Visits all bodies and fixtures once, which is cheap enough to be
+         * done periodically, e.g., once per second. The peak is updated
+         * with each report, hence it only reflects the reported totals.
+         *
+         * @return the memory report
+         */
+        MemoryReport GetMemoryReport();
+
+        /**
+         * Discards the shapes cooked from a polygon.
+         *
+         * Polygons of polygon colliders are considered immutable once
+         * bodies have been created with them, since the shapes cooked from
+         * a polygon are cached and shared. A polygon changed afterwards must
+         * be invalidated. Bodies created afterwards use the changed polygon,
+         * existing bodies keep their fixtures until they are added again.
+         *
+         * @param polygon   the polygon which has been changed
+         */
+        void InvalidatePolygon(const Polygon& polygon);
+
+        /**
+         * Discards the shapes cooked from polygons which have been destroyed.
+         *
+         * The cache does not keep polygons alive and purges itself as it
+         * grows, purging explicitly releases memory early, e.g., after
+         * unloading a level.
+         */
+        void PurgeShapeCache();
+
+        /**
+         * Returns the contact events recorded during the last update.
+         *
+         * The returned events are valid until the next update of this
+         * system. The buffer is reused between updates and does not
+         * allocate memory as long as its capacity suffices.
+         *
+         * @return the contact events of the last update
+         */
+        const std::vector<ContactEvent>& GetContactEvents() const {
+            return asyncStep ? publishedEvents : contactEvents;
+        }
+
+        /**
+         * Reserves space for the specified number of contact events.
+         *
+         * @param n the number of contact events per update
+         * @return reference to this system for method chaining
+         */
+        Box2DPhysicsSystem& SetContactEventCapacity(size_t n);
+
+        /**
+         * Specifies whether to publish collision signals.
+         *
+         * If enabled, a collision signal is queued at the collision signal
+         * service for each begin contact event, provided that such a
+         * service is available. Enabled by default.
+         *
+         * @param b `true` to publish collision signals
+         * @return reference to this system for method chaining
+         */
+        Box2DPhysicsSystem& SetCollisionSignaling(bool b);
+
+        /**
+         * Returns whether collision signals are published.
+         *
+         * @return `true` if collision signals are published
+         */
+        bool IsCollisionSignaling() const {
+            return collisionSignaling;
+        }
+
+        /**
+         * Specifies whether to record impact events.
+         *
+         * If enabled, the impulses applied by the solver are examined and
+         * an impact event is recorded for each contact whose maximum normal
+         * impulse during an update reaches the impact threshold, while it
+         * stayed below the threshold during the previous update the contact
+         * has been solved. Each contact reports at most one impact per
+         * update, resting contacts report once when they begin pushing
+         * harder than the threshold. Disabled by default.
+         *
+         * @param b `true` to record impact events
+         * @return reference to this system for method chaining
+         */
+        Box2DPhysicsSystem& SetImpactEvents(bool b);
+
+        /**
+         * Returns whether impact events are recorded.
+         *
+         * @return `true` if impact events are recorded
+         */
+        bool IsImpactEvents() const {
+            return impactEvents;
+        }
+
+        /**
+         * Sets the normal impulse required to record an impact event.
+         *
+         * This threshold applies to colliders without a threshold of
+         * their own. If both colliders specify a threshold, the smaller
+         * one is used.
+         *
+         * @param threshold the impact threshold
+         * @return reference to this system for method chaining
+         */
+        Box2DPhysicsSystem& SetImpactThreshold(float threshold);
+
+        /**
+         * Returns the normal impulse required to record an impact event.
+         *
+         * @return the impact threshold
+         */
+        float GetImpactThreshold() const {
+            return impactThreshold;
+        }
+
+        /**
+         * Returns the impact events recorded during the last update.
+         *
+         * The returned events are valid until the next update of this
+         * system.
+         *
+         * @return the impact events of the last update
+         */
+        const std::vector<ImpactEvent>& GetImpactEvents() const {
+            return asyncStep ? publishedImpacts : impacts;
+        }
+
+        /**
+         * Returns the sensor events recorded during the last update.
+         *
+         * Entities leaving sensors because bodies have been destroyed or
+         * disabled are reported as well. The returned events are valid
+         * until the next update of this system.
+         *
+         * @return the sensor events of the last update
+         */
+        const std::vector<SensorEvent>& GetSensorEvents() const {
+            return asyncStep ? publishedSensorEvents : sensorEvents;
+        }
+
+        /**
+         * Sets the number of additional threads used for batched queries
+         * and for synchronizing the transforms of many bodies.
+         *
+         * Zero means that batched queries and transforms are processed by
+         * the calling thread only.
+         *
+         * @param n the number of worker threads
+         * @return reference to this system for method chaining
+         */
+        Box2DPhysicsSystem& SetWorkerThreads(unsigned int n);
+
+        /**
+         * Returns the number of additional threads used for batched queries.
+         *
+         * @return the number of worker threads
+         */
+        unsigned int GetWorkerThreads() const {
+            return workerThreads;
+        }
+
+        /**
+         * Sets the number of bodies from which on transforms are
+         * synchronized in parallel.
+         *
+         * Poses are exchanged between entities and Box2D in chunks of
+         * consecutive bindings processed by the worker threads. The
+         * results do not depend on the number of threads. Below the
+         * threshold the overhead of distributing the work outweighs
+         * the gain, hence transforms are synchronized by the calling
+         * thread. Without worker threads this setting has no effect.
+         *
+         * @param n the minimum number of bodies
+         * @return reference to this system for method chaining
+         */
+        Box2DPhysicsSystem& SetParallelSyncThreshold(size_t n);
+
+        /**
+         * Returns the number of bodies from which on transforms are
+         * synchronized in parallel.
+         *
+         * @return the minimum number of bodies
+         */
+        size_t GetParallelSyncThreshold() const {
+            return parallelSyncThreshold;
+        }
+
+        /**
+         * Sets the number of consecutive bindings synchronized as one chunk
+         * in parallel.
+         *
+         * Threads write to the arrays of the binding table in chunks, hence
+         * they share cache lines of these arrays at chunk boundaries only.
+         * The poses of the entities are not part of the binding table; pose
+         * components of neighboring entities can share cache lines across
+         * chunks, depending on how they have been allocated. Larger chunks
+         * reduce the scheduling overhead, smaller chunks balance the load
+         * better. The `sync` benchmark measures the effect of the chunk
+         * size. The default is 4096 bindings.
+         *
+         * @param n the number of bindings per chunk
+         * @return reference to this system for method chaining
+         * @throws std::logic_error in case the number is zero
+         */
+        Box2DPhysicsSystem& SetParallelSyncGrain(size_t n);
+
+        /**
+         * Returns the number of consecutive bindings synchronized as one
+         * chunk in parallel.
+         *
+         * @return the number of bindings per chunk
+         */
+        size_t GetParallelSyncGrain() const {
+            return parallelSyncGrain;
+        }
+
+        /**
+         * Enables or disables profiling.
+         *
+         * If enabled, the phases of each update are timed and the
+         * statistics of recent updates are kept for summaries. Disabled
+         * profiling does not cause any overhead.
+         *
+         * @param b `true` to enable profiling
+         * @return reference to this system for method chaining
+         */
+        Box2DPhysicsSystem& SetProfiling(bool b);
+
+        /**
+         * Returns whether profiling is enabled.
+         *
+         * @return `true` if profiling is enabled
+         */
+        bool IsProfiling() const {
+            return profiler != nullptr;
+        }
+
+        /**
+         * Sets the number of recent updates kept for profile summaries.
+         *
+         * @param n the number of updates
+         * @return reference to this system for method chaining
+         */
+        Box2DPhysicsSystem& SetProfileWindow(size_t n);
+
+        /**
+         * Returns the number of recent updates kept for profile summaries.
+         *
+         * @return the number of updates
+         */
+        size_t GetProfileWindow() const {
+            return profileWindow;
+        }
+
+        /**
+         * Specifies the file to write a trace of all updates to.
+         *
+         * The trace uses the Chrome trace event format and is written
+         * while profiling is enabled. An empty filename stops tracing.
+         *
+         * @param filename  the name of the trace file
+         * @return reference to this system for method chaining
+         * @throws std::runtime_error in case the file cannot be opened
+         */
+        Box2DPhysicsSystem& SetTraceFile(const std::string& filename);
+
+        /**
+         * Summarizes a timing over the recent updates.
+         *
+         * @param metric    the timing to summarize
+         * @return the summary, empty if profiling is disabled
+         */
+        ProfileSummary GetProfileSummary(ProfileMetric metric) const;
+
+        /**
+         * Returns the statistics of the last update.
+         *
+         * @return the statistics of the last update
+         */
+        const StepStats& GetStepStats() const {
+            return asyncStep ? publishedStats : stepStats;
+        }
+
+        /**
+         * Specifies whether the world is stepped asynchronously.
+         *
+         * In asynchronous mode, each update finishes the step started by
+         * the previous update, deploys its results and starts the next
+         * step on a worker thread, which runs while the rest of the frame
+         * is processed. Poses, velocities, events and statistics refer to
+         * the last finished step, hence lag one update behind.
+         *
+         * While a step is running, changes of bodies and colliders are
+         * collected by the command buffers used for deferred commands,
+         * the creation and destruction of bodies is queued as well. Both
+         * are applied by the next update. Queries wait for the running
+         * step to finish. Asynchronous stepping cannot be combined with
+         * world groups.
+         *
+         * Worlds stepped at the same time, e.g., by several asynchronous
+         * systems, update the global diagnostic counters of Box2D without
+         * synchronization, see Box2DWorldGroup.
+         *
+         * @param b `true` to step asynchronously
+         * @return reference to this system for method chaining
+         * @throws std::logic_error in case this system belongs to a world group
+         */
+        Box2DPhysicsSystem& SetAsyncStep(bool b);
+
+        /**
+         * Returns whether the world is stepped asynchronously.
+         *
+         * @return `true` if stepping asynchronously
+         */
+        bool IsAsyncStep() const {
+            return asyncStep;
+        }
+
+        /**
+         * Returns the world group stepping this system.
+         *
+         * @return the world group or `nullptr` if this system steps itself
+         */
+        Box2DWorldGroup* GetWorldGroup() const {
+            return group;
+        }
+
+        /**
+         * Specifies whether bodies are allowed to fall asleep.
+         *
+         * Applies to the whole world, bodies can additionally be prevented
+         * from sleeping individually. The sleep thresholds are compile-time
+         * settings of Box2D (`b2_linearSleepTolerance`,
+         * `b2_angularSleepTolerance`, `b2_timeToSleep`).
+         *
+         * @param b `true` to allow sleeping
+         * @return reference to this system for method chaining
+         */
+        Box2DPhysicsSystem& SetSleepingAllowed(bool b);
+
+        /**
+         * Returns whether bodies are allowed to fall asleep.
+         *
+         * @return `true` if sleeping is allowed
+         */
+        bool IsSleepingAllowed() const {
+            return sleepingAllowed;
+        }
+
+        /**
+         * Adds an interest region.
+         *
+         * As long as at least one interest region exists, non-static
+         * bodies outside of all regions become dormant according to the
+         * region mode. Regions are evaluated at the beginning of each
+         * update, dormant bodies are reactivated as soon as a region
+         * covers them again.
+         *
+         * While the regions stay the same, only moving bodies are
+         * evaluated. Adding, changing or removing regions makes the next
+         * update evaluate all bodies once.
+         *
+         * @param region    the region to add
+         * @return the index of the new region
+         */
+        size_t AddInterestRegion(const InterestRegion& region);
+
+        /**
+         * Updates an interest region, e.g., to follow a player.
+         *
+         * The next update evaluates all bodies, hence regions should
+         * only be updated when they have actually moved.
+         *
+         * @param idx       the index of the region
+         * @param region    the new region
+         * @throws std::logic_error in case the index is invalid
+         */
+        void SetInterestRegion(size_t idx, const InterestRegion& region);
+
+        /**
+         * Returns an interest region.
+         *
+         * @param idx   the index of the region
+         * @return the region
+         * @throws std::logic_error in case the index is invalid
+         */
+        const InterestRegion& GetInterestRegion(size_t idx) const;
+
+        /**
+         * Returns the number of interest regions.
+         *
+         * @return the number of regions
+         */
+        size_t NumInterestRegions() const {
+            return regions.size();
+        }
+
+        /**
+         * Removes an interest region.
+         *
+         * The indices of subsequent regions are decremented by one.
+         *
+         * @param idx   the index of the region
+         * @throws std::logic_error in case the index is invalid
+         */
+        void RemoveInterestRegion(size_t idx);
+
+        /**
+         * Removes all interest regions.
+         *
+         * Dormant bodies are reactivated during the next update.
+         */
+        void ClearInterestRegions();
+
+        /**
+         * Specifies how bodies outside of all interest regions are treated.
+         *
+         * Dormant bodies are reactivated when the mode changes.
+         *
+         * @param mode  the region mode
+         * @return reference to this system for method chaining
+         */
+        Box2DPhysicsSystem& SetRegionMode(RegionMode mode);
+
+        /**
+         * Returns how bodies outside of all interest regions are treated.
+         *
+         * @return the region mode
+         */
+        RegionMode GetRegionMode() const {
+            return regionMode;
+        }
+
+        /**
+         * Sets the distance bodies must exceed beyond interest regions to become dormant.
+         *
+         * Bodies are reactivated inside the radius of a region but only
+         * become dormant beyond the radius plus this margin, which avoids
+         * bodies at the border toggling between both states.
+         *
+         * @param margin    the margin, must not be negative
+         * @return reference to this system for method chaining
+         * @throws std::logic_error in case the margin is negative
+         */
+        Box2DPhysicsSystem& SetRegionMargin(float margin);
+
+        /**
+         * Returns the distance bodies must exceed beyond interest regions to become dormant.
+         *
+         * @return the margin
+         */
+        float GetRegionMargin() const {
+            return regionMargin;
+        }
+
+        /**
+         * Returns the number of bodies currently dormant.
+         *
+         * @return the number of dormant bodies
+         */
+        size_t NumDormantBodies() const {
+            return numDormant;
+        }
+
+        /**
+         * Saves the state of the physics world.
+         *
+         * Pending bodies are created and destroyed before saving. The
+         * memory of the snapshot is reused.
+         *
+         * @param snapshot  receives the state
+         */
+        void SaveSnapshot(PhysicsSnapshot& snapshot);
+
+        /**
+         * Restores the state of the physics world.
+         *
+         * Existing bodies are updated in place. Bodies of entities which
+         * no longer exist are skipped, bodies not contained in the
+         * snapshot remain unchanged. The manifolds of all contacts of the
+         * restored bodies are cleared first, then the warm-starting
+         * impulses are restored for saved contacts which still exist.
+         * Other contacts start without warm-starting, hence restoring the
+         * same snapshot yields the same next step regardless of the
+         * current state. The poses of the entities are updated
+         * immediately.
+         *
+         * Box2D does not expose the sleep timers of bodies, they are
+         * neither saved nor restored. Waking up a body resets its timer,
+         * hence bodies close to falling asleep might fall asleep later
+         * after restoring than in the original run.
+         *
+         * @param snapshot  the state to restore
+         * @throws std::runtime_error in case the snapshot is malformed
+         */
+        void RestoreSnapshot(const PhysicsSnapshot& snapshot);
+
+        /**
+         * Specifies whether to compute a hash of the world state after each step.
+         *
+         * The hash covers the awake state, transforms and velocities of
+         * all non-static bodies and can be compared between runs or machines to detect
+         * divergence of the simulation.
+         *
+         * @param b `true` to enable state hashing
+         * @return reference to this system for method chaining
+         */
+        Box2DPhysicsSystem& SetStateHashing(bool b);
+
+        /**
+         * Returns whether state hashing is enabled.
+         *
+         * @return `true` if state hashing is enabled
+         */
+        bool IsStateHashing() const {
+            return stateHashing;
+        }
+
+        /**
+         * Returns the hash of the world state after the last step.
+         *
+         * @return the state hash, zero if neither hashing nor recording is enabled
+         */
+        uint64_t GetStateHash() const {
+            return stateHash;
+        }
+
+        /**
+         * Starts recording the inputs of the physics world.
+         *
+         * Records the existing bodies, created and destroyed bodies,
+         * teleported poses, commands issued to bodies, changes of collider
+         * materials, filters and sensors, gravity changes and each step
+         * including the resulting state hash. The recording can be
+         * replayed headless by `Box2DReplayer` to reproduce the
+         * simulation. Restored snapshots are not recorded. A running
+         * recording is stopped.
+         *
+         * Box2D keeps internal state which cannot be recorded, e.g., the
+         * order of broad-phase proxies and contacts or the time bodies
+         * have been resting. The world is therefore rebuilt in the way
+         * the replay builds it: bodies are created anew in binding order
+         * and contacts are created without being reported again. Impulses
+         * of touching contacts are carried over and recorded. Sleep timers
+         * start at zero and forces applied since the last update are
+         * lost. Contacts of sleeping bodies are created once the bodies
+         * wake up, hence they are reported to begin again.
+         *
+         * This system must be started.
+         *
+         * @param filename  the name of the recording file
+         * @throws std::runtime_error in case the file cannot be opened
+         * @throws std::logic_error in case this system is not started
+         */
+        void StartRecording(const std::string& filename);
+
+        /**
+         * Stops recording and closes the recording file.
+         */
+        void StopRecording();
+
+        /**
+         * Returns whether the inputs of the physics world are recorded.
+         *
+         * @return `true` if recording
+         */
+        bool IsRecording() const {
+            return recorder != nullptr;
+        }
+
+        /**
+         * Casts a ray and determines the closest hit.
+         *
+         * Queries must not be issued while this system is updated.
+         *
+         * @param query the ray to cast
+         * @param hit   receives the closest hit
+         * @return `true` if the ray has hit a collider
+         */
+        bool RayCast(const RayCastQuery& query, RayCastHit& hit) const;
+
+        /**
+         * Casts a batch of rays and determines the closest hit of each ray.
+         *
+         * Rays are distributed among the worker threads, the calling
+         * thread takes part and this method returns once all rays have
+         * been processed. Queries must not be issued while this system is
+         * updated.
+         *
+         * @param queries   the rays to cast
+         * @param hits      receives the closest hits, one per ray
+         * @param count     the number of rays
+         */
+        void RayCast(const RayCastQuery* queries, RayCastHit* hits, size_t count);
+
+        /**
+         * Determines the colliders which bounding boxes overlap a box.
+         *
+         * The results are written to the specified buffer, the query
+         * terminates once the buffer is full. Queries must not be issued
+         * while this system is updated.
+         *
+         * @param lower     the lower bound of the axis-aligned box
+         * @param upper     the upper bound of the axis-aligned box
+         * @param filter    selects the colliders to consider
+         * @param hits      receives the colliders found
+         * @param capacity  the maximum number of results
+         * @return the number of colliders found
+         */
+        size_t QueryAABB(const Vector2f& lower, const Vector2f& upper, const QueryFilter& filter, OverlapHit* hits, size_t capacity) const;
+
+        /**
+         * Determines the colliders which bounding boxes overlap a box.
+         *
+         * @param lower     the lower bound of the axis-aligned box
+         * @param upper     the upper bound of the axis-aligned box
+         * @param filter    selects the colliders to consider
+         * @param listener  receives the colliders found
+         */
+        void QueryAABB(const Vector2f& lower, const Vector2f& upper, const QueryFilter& filter, OverlapListener& listener) const;
+
+        /**
+         * Determines the colliders overlapping a circle.
+         *
+         * @param center    the center of the circle in world coordinates
+         * @param radius    the radius of the circle
+         * @param filter    selects the colliders to consider
+         * @param hits      receives the colliders found
+         * @param capacity  the maximum number of results
+         * @return the number of colliders found
+         */
+        size_t OverlapCircle(const Vector2f& center, float radius, const QueryFilter& filter, OverlapHit* hits, size_t capacity) const;
+
+        /**
+         * Determines the colliders overlapping a circle.
+         *
+         * @param center    the center of the circle in world coordinates
+         * @param radius    the radius of the circle
+         * @param filter    selects the colliders to consider
+         * @param listener  receives the colliders found
+         */
+        void OverlapCircle(const Vector2f& center, float radius, const QueryFilter& filter, OverlapListener& listener) const;
+
+        /**
+         * Determines the colliders overlapping an oriented box.
+         *
+         * @param center        the center of the box in world coordinates
+         * @param halfExtents   the half width and half height of the box
+         * @param angle         the orientation of the box in radians
+         * @param filter        selects the colliders to consider
+         * @param hits          receives the colliders found
+         * @param capacity      the maximum number of results
+         * @return the number of colliders found
+         */
+        size_t OverlapBox(const Vector2f& center, const Vector2f& halfExtents, float angle, const QueryFilter& filter, OverlapHit* hits, size_t capacity) const;
+
+        /**
+         * Determines the colliders overlapping a convex polygon.
+         *
+         * The polygon must not have more than eight vertices.
+         *
+         * @param vertices  the vertices of the polygon in local coordinates
+         * @param count     the number of vertices
+         * @param position  the position of the polygon in world coordinates
+         * @param angle     the orientation of the polygon in radians
+         * @param filter    selects the colliders to consider
+         * @param hits      receives the colliders found
+         * @param capacity  the maximum number of results
+         * @return the number of colliders found
+         */
+        size_t OverlapPolygon(const Vector2f* vertices, size_t count, const Vector2f& position, float angle, const QueryFilter& filter, OverlapHit* hits, size_t capacity) const;
+
+        /**
+         * Determines the colliders overlapping a convex polygon.
+         *
+         * @param vertices  the vertices of the polygon in local coordinates
+         * @param count     the number of vertices
+         * @param position  the position of the polygon in world coordinates
+         * @param angle     the orientation of the polygon in radians
+         * @param filter    selects the colliders to consider
+         * @param listener  receives the colliders found
+         */
+        void OverlapPolygon(const Vector2f* vertices, size_t count, const Vector2f& position, float angle, const QueryFilter& filter, OverlapListener& listener) const;
+
+        /**
+         * Sweeps a circle along a vector and determines the first impact.
+         *
+         * @param center        the start position of the circle
+         * @param radius        the radius of the circle
+         * @param translation   the translation of the sweep
+         * @param filter        selects the colliders to consider
+         * @param hit           receives the first impact
+         * @return `true` if the circle hits a collider
+         */
+        bool SweepCircle(const Vector2f& center, float radius, const Vector2f& translation, const QueryFilter& filter, SweepHit& hit) const;
+
+        /**
+         * Sweeps a convex polygon and determines the first impact.
+         *
+         * The impact is computed using time of impact, hence the polygon
+         * might rotate during the sweep.
+         *
+         * @param vertices      the vertices of the polygon in local coordinates
+         * @param count         the number of vertices
+         * @param position      the start position of the polygon
+         * @param angle         the start orientation of the polygon in radians
+         * @param translation   the translation of the sweep
+         * @param rotation      the rotation of the sweep in radians
+         * @param filter        selects the colliders to consider
+         * @param hit           receives the first impact
+         * @return `true` if the polygon hits a collider
+         */
+        bool SweepPolygon(const Vector2f* vertices, size_t count, const Vector2f& position, float angle, const Vector2f& translation, float rotation, const QueryFilter& filter, SweepHit& hit) const;
+
 
         /**
          * Returns the gravity vector used for physics simulation.
@@ -112,6 +1172,15 @@ namespace astu::suite2d {
         // Inherited via CPolygonColliderFactory
         virtual std::shared_ptr<CPolygonCollider> CreatePolygonCollider() override;
 
+        // Inherited via CChainColliderFactory
+        virtual std::shared_ptr<CChainCollider> CreateChainCollider() override;
+
+        // Inherited via CEdgeColliderFactory
+        virtual std::shared_ptr<CEdgeCollider> CreateEdgeCollider() override;
+
+        // Inherited via CCompoundColliderFactory
+        virtual std::shared_ptr<CCompoundCollider> CreateCompoundCollider() override;
+
     private:
         /** The family of entities this system processes. */
         static const EntityFamily FAMILY;
@@ -125,6 +1194,24 @@ namespace astu::suite2d {
 		/** Number of iterations for the position phase constraint solver. */
 		int positionIterations;
 
+        /** Whether to advance the world in steps of constant size. */
+        bool fixedTimeStep;
+
+        /** The step size used for fixed-timestep simulation. */
+        float stepSize;
+
+        /** The maximum number of steps performed within one update. */
+        int maxSubSteps;
+
+        /** The accumulated time not yet simulated. */
+        float accumulator;
+
+        /** Whether to interpolate poses between steps. */
+        bool interpolation;
+
+        /** Whether to push the poses of all non-static bodies. */
+        bool alwaysPushPoses;
+
         /** The gravity vector. */
         Vector2f gravity;
 
@@ -134,6 +1221,235 @@ namespace astu::suite2d {
         /** Used to publish collision events. */
         std::shared_ptr<CollisionSignalService> collisionSignals;
 
+        /** Whether to publish collision signals. */
+        bool collisionSignaling;
+
+        /** The contact events recorded during the last update. */
+        std::vector<ContactEvent> contactEvents;
+
+        /** Whether to record impact events. */
+        bool impactEvents;
+
+        /** The normal impulse required to record an impact event. */
+        float impactThreshold;
+
+        /** The impact events recorded during the last update. */
+        std::vector<ImpactEvent> impacts;
+
+        /** The impulses of a touching contact examined for impact events. */
+        struct ContactImpact {
+
+            /** The update the peak belongs to. */
+            uint32_t update;
+
+            /** The maximum normal impulse during that update. */
+            float peak;
+
+            /** The maximum normal impulse during the update solved before. */
+            float previousPeak;
+
+            /** The index of the impact event of that update, -1 if none. */
+            int event;
+        };
+
+        /** The impulses of touching contacts, entries are removed when contacts end. */
+        std::unordered_map<const b2Contact*, ContactImpact> contactImpacts;
+
+        /** Counts updates, distinguishes the impulses of different updates. */
+        uint32_t impactUpdate;
+
+        /** The number of additional threads used for batched queries. */
+        unsigned int workerThreads;
+
+        /** Used to process batched queries and transforms in parallel. */
+        std::unique_ptr<WorkerPool> workerPool;
+
+        /** The number of bodies from which on transforms are synchronized in parallel. */
+        size_t parallelSyncThreshold;
+
+        /** The number of consecutive bindings synchronized as one chunk in parallel. */
+        size_t parallelSyncGrain;
+
+        /**
+         * The bindings found by one chunk of a parallel synchronization.
+         *
+         * Aligned to cache lines, threads filling adjacent chunks must not
+         * share the lines holding the vectors.
+         */
+        struct alignas(64) SyncChunk {
+            std::vector<int> indices;
+        };
+
+        /** The results of the chunks of parallel synchronization. */
+        std::vector<SyncChunk> syncChunks;
+
+        /** Binds entities to Box2D bodies. */
+        std::unique_ptr<BindingTable> bindings;
+
+        /** Cooked shapes of polygon colliders. */
+        std::unique_ptr<ShapeCache> shapeCache;
+
+        /** The world group stepping this system, if any. */
+        Box2DWorldGroup* group;
+
+        /** The number of steps to perform during the current update. */
+        int pendingSteps;
+
+        /** The size of the steps to perform during the current update. */
+        float pendingStepSize;
+
+        /** The statistics of the last update. */
+        StepStats stepStats;
+
+        /** Whether to defer creation and destruction of bodies. */
+        bool deferredSpawning;
+
+        /** The entities waiting for their bodies to be created. */
+        std::vector<Entity*> pendingSpawns;
+
+        /** The entities waiting for their bodies to be destroyed. */
+        std::vector<std::shared_ptr<Entity>> pendingDespawns;
+
+        /** Used to profile updates, `nullptr` if profiling is disabled. */
+        std::unique_ptr<Profiler> profiler;
+
+        /** The number of recent updates kept for profile summaries. */
+        size_t profileWindow;
+
+        /** The name of the trace file, empty if no trace is written. */
+        std::string traceFile;
+
+        /**
+         * Entities and their binding indices sorted by entity, used to
+         * restore snapshots. Kept to reuse its memory.
+         */
+        std::vector<std::pair<const Entity*, int>> bindingLookup;
+
+        /** Whether to compute a hash of the world state after each step. */
+        bool stateHashing;
+
+        /** The hash of the world state after the last step. */
+        uint64_t stateHash;
+
+        /** Records the inputs of the world, `nullptr` if not recording. */
+        std::unique_ptr<StepRecorder> recorder;
+
+        /** Whether bodies are allowed to fall asleep. */
+        bool sleepingAllowed;
+
+        /** The interest regions. */
+        std::vector<InterestRegion> regions;
+
+        /** Determines how bodies outside of all interest regions are treated. */
+        RegionMode regionMode;
+
+        /** The distance bodies must exceed beyond regions to become dormant. */
+        float regionMargin;
+
+        /** The number of dormant bodies. */
+        size_t numDormant;
+
+        /** Whether regions have changed since dormancy has been evaluated for all bodies. */
+        bool regionsChanged;
+
+        /** Whether the world is stepped asynchronously. */
+        bool asyncStep;
+
+        /** Steps the world asynchronously, `nullptr` in synchronous mode. */
+        std::unique_ptr<AsyncStepper> stepper;
+
+        /** Whether a step has been started which results are not yet deployed. */
+        bool stepPending;
+
+        /** Whether changes of bodies and colliders are deferred until the next step. */
+        bool deferredCommands;
+
+        /** The bodies and colliders with pending changes. */
+        std::unique_ptr<CommandQueue> commandQueue;
+
+        /** The bodies with pending changes, ordered before they are applied. */
+        std::vector<CBox2DBody*> commandBodies;
+
+        /** The colliders with pending changes, ordered before they are applied. */
+        std::vector<ColliderCommand> commandColliders;
+
+        /** The contact events of the last finished step in asynchronous mode. */
+        std::vector<ContactEvent> publishedEvents;
+
+        /** The impact events of the last finished step in asynchronous mode. */
+        std::vector<ImpactEvent> publishedImpacts;
+
+        /** The statistics of the last finished update in asynchronous mode. */
+        StepStats publishedStats;
+
+        /** The sensor contacts recorded during the steps of the current update. */
+        std::vector<SensorContact> sensorContacts;
+
+        /** The sensor events of the current update. */
+        std::vector<SensorEvent> sensorEvents;
+
+        /** The number of sensor events already reported by the last update. */
+        size_t reportedSensorEvents;
+
+        /** The sensor events of the last finished step in asynchronous mode. */
+        std::vector<SensorEvent> publishedSensorEvents;
+
+        /** The capacity reserved each time the world is created. */
+        WorldCapacity capacity;
+
+        /** The peak memory of the block allocator of the current world. */
+        size_t worldBlockPeak;
+
+        /** The peak number of broad-phase tree nodes of the current world. */
+        size_t worldNodePeak;
+
+        /** The highest total of all memory reports since startup. */
+        size_t memoryPeak;
+
+        /** Whether continuous collision is enabled. */
+        bool continuousPhysics;
+
+        /** The time budget and lower quality bounds of the adaptive solver. */
+        SolverBudget solverBudget;
+
+        /** Adjusts the solver settings, `nullptr` if the adaptive solver is disabled. */
+        std::unique_ptr<SolverController> solverController;
+
+        /** The solver settings used for the next step. */
+        SolverLevel solverLevel;
+
+        /**
+         * Returns the solver settings of the highest quality.
+         *
+         * @return the configured solver settings
+         */
+        SolverLevel GetBestSolverLevel() const;
+
+        /**
+         * Determines the solver settings used for the next step.
+         */
+        void ApplySolverLevel();
+
+        /**
+         * Creates an empty physics world of the reserved capacity.
+         */
+        void CreateWorld();
+
+        /**
+         * Reserves the capacity of the world by placeholder objects.
+         *
+         * Contacts are reserved only if the world is empty and the contact
+         * listener has not been installed yet.
+         */
+        void ReserveWorldCapacity();
+
+        /**
+         * Detaches all entities from their bodies without destroying them.
+         *
+         * Used when the world is destroyed as a whole.
+         */
+        void UnbindAll();
+
         /**
          * Creates fixtures according to the collider components of the entity.
          * 
@@ -142,10 +1458,316 @@ namespace astu::suite2d {
          */
         void AddFixture(Entity& entity, b2Body& body);
 
+        /**
+         * Creates the bodies of all pending entities.
+         */
+        void FlushSpawns();
+
+        /**
+         * Destroys the bodies of all entities pending removal.
+         */
+        void FlushDespawns();
+
+        /**
+         * Creates the Box2D body of an entity and binds it.
+         *
+         * @param entity    the entity
+         */
+        void SpawnBody(Entity& entity);
+
+        /**
+         * Destroys a Box2D body and removes its binding.
+         *
+         * @param body  the body component
+         */
+        void DespawnBody(CBox2DBody& body);
+
+        /**
+         * Adds the specified body to the list of active bodies.
+         *
+         * @param body  the body to add
+         */
+        void ActivateBody(CBox2DBody& body);
+
+        /**
+         * Updates the binding of the specified body after its type has changed.
+         *
+         * @param body  the body which type has changed
+         */
+        void UpdateBodyType(CBox2DBody& body);
+
+        /**
+         * Adds bodies woken up by touching active bodies to the active list.
+         */
+        void GatherActiveBodies();
+
+        /**
+         * Puts bodies outside of all interest regions to rest and reactivates others.
+         *
+         * All bodies are evaluated after regions have changed, otherwise
+         * only active bodies.
+         */
+        void UpdateDormancy();
+
+        /**
+         * Puts a binding outside of all interest regions to rest or
+         * reactivates it.
+         *
+         * @param idx   the index of the binding
+         */
+        void UpdateDormancy(size_t idx);
+
+        /**
+         * Removes a binding which came to rest from the active list.
+         *
+         * @param idx   the index of the binding
+         */
+        void SettleBody(size_t idx);
+
+        /**
+         * Tests whether a point lies within an interest region.
+         *
+         * @param x         the x-coordinate of the point
+         * @param y         the y-coordinate of the point
+         * @param margin    the distance added to the radius of the regions
+         * @return `true` if the point lies within a region
+         */
+        bool IsOfInterest(float x, float y, float margin) const;
+
+        /**
+         * Makes a binding dormant according to the region mode.
+         *
+         * @param idx   the index of the binding
+         */
+        void MakeDormant(size_t idx);
+
+        /**
+         * Reactivates a dormant binding.
+         *
+         * @param idx   the index of the binding
+         */
+        void Reactivate(size_t idx);
+
+        /**
+         * Reactivates all dormant bindings.
+         */
+        void ReactivateAll();
+
+        /**
+         * Tests whether a body is dormant.
+         *
+         * @param body  the body component
+         * @return `true` if the body is dormant
+         */
+        bool IsDormant(const CBox2DBody& body) const;
+
+        /**
+         * Prepares an update, determines the steps to perform.
+         *
+         * Must be called on the thread updating the entity system.
+         */
+        void BeginUpdate();
+
+        /**
+         * Performs the steps determined by `BeginUpdate`.
+         *
+         * Only accesses the Box2D world and data owned by this system,
+         * hence different systems can be simulated concurrently.
+         */
+        void Simulate();
+
+        /**
+         * Finishes an update, deploys transforms and publishes signals.
+         *
+         * Must be called on the thread updating the entity system.
+         */
+        void EndUpdate();
+
+        /**
+         * Finishes the pending step and starts the next one on the worker thread.
+         */
+        void UpdateAsync();
+
+        /**
+         * Finishes the pending step and deploys its results.
+         */
+        void FinishAsyncStep();
+
+        /**
+         * Waits until the running step, if any, has finished.
+         *
+         * Results are not deployed, the world may be accessed afterwards.
+         */
+        void WaitForStep() const;
+
+        /**
+         * Returns whether a step is running on the worker thread.
+         *
+         * @return `true` if the world must not be accessed
+         */
+        bool IsStepping() const;
+
+        /**
+         * Tests whether changes of bodies and colliders are deferred.
+         *
+         * @return `true` if changes are deferred
+         */
+        bool IsDeferringCommands() const;
+
+        /**
+         * Returns the command buffer of the calling thread.
+         *
+         * @return the command buffer
+         */
+        CommandBuffer& GetCommandBuffer();
+
+        /**
+         * Applies the pending changes of all bodies and colliders.
+         */
+        void ApplyCommands();
+
+        /**
+         * Casts a ray without waiting for a running step.
+         *
+         * @param query the ray to cast
+         * @param hit   receives the closest hit
+         * @return `true` if something has been hit
+         */
+        bool CastRay(const RayCastQuery& query, RayCastHit& hit) const;
+
+        /**
+         * Carries the state of a contact over from the world replaced when
+         * recording starts.
+         *
+         * Impulses of ordinary contacts are copied and recorded, sensor
+         * contacts are added to the overlap sets.
+         *
+         * @param contact   the touching contact of the new world
+         * @param oldBodies the bodies of the old world in binding order
+         */
+        void TransferContact(b2Contact& contact, const std::vector<b2Body*>& oldBodies);
+
         void CollectTransforms();
-        void DeployTransforms();
+        void StorePreviousTransforms();
+        void DeployTransforms(float alpha);
+
+        /**
+         * Tests whether transforms are synchronized in parallel.
+         *
+         * @return `true` if the number of bodies reaches the threshold
+         */
+        bool IsParallelSync() const;
+
+        /**
+         * Runs a function over chunks of all bindings in parallel.
+         *
+         * Each chunk clears and fills its own list of binding indices.
+         * The lists are ordered by binding index.
+         *
+         * @param func  the function processing the range of a chunk
+         */
+        void ForEachSyncChunk(const std::function<void(size_t begin, size_t end, std::vector<int>& out)>& func);
+
+        /**
+         * Tests whether the pose of an entity has been changed outside
+         * this system.
+         *
+         * @param idx   the index of the binding
+         * @return `true` if the pose must be pushed to Box2D
+         */
+        bool IsPoseChanged(size_t idx) const;
+
+        /**
+         * Pushes the pose of an entity to its Box2D body.
+         *
+         * @param idx   the index of the binding
+         */
+        void PushPose(size_t idx);
+
+        /**
+         * Deploys the transform of a body to its entity.
+         *
+         * @param idx   the index of the binding
+         * @param alpha the interpolation factor
+         * @return `false` if the binding must be deactivated
+         */
+        bool DeployTransform(size_t idx, float alpha);
         void HandleCollision(std::shared_ptr<Entity> a, std::shared_ptr<Entity> b);
 
+        /**
+         * Records a contact event reported by Box2D.
+         *
+         * @param contact   the Box2D contact
+         * @param type      the type of the event
+         */
+        void RecordContact(b2Contact& contact, ContactEvent::Type type);
+
+        /**
+         * Records the contacts of sensor fixtures.
+         *
+         * @param fixture   the fixture which might be a sensor
+         * @param other     the fixture touching it
+         * @param begin     whether the contact began touching
+         */
+        void RecordSensorContact(b2Fixture& fixture, b2Fixture& other, bool begin);
+
+        /**
+         * Applies a sensor contact to the overlap set of the sensor.
+         *
+         * @param contact   the sensor contact
+         */
+        void UpdateSensor(const SensorContact& contact);
+
+        /**
+         * Applies all sensor contacts recorded during the steps of the current update.
+         */
+        void UpdateSensors();
+
+        /**
+         * Records an impact event if the maximum impulse of a contact
+         * during the current update crosses the threshold.
+         *
+         * @param contact   the Box2D contact
+         * @param impulse   the impulses applied by the solver
+         */
+        void RecordImpact(b2Contact& contact, const b2ContactImpulse& impulse);
+
+        /**
+         * Returns the entity a Box2D fixture belongs to.
+         *
+         * @param fixture   the Box2D fixture
+         * @return the entity
+         */
+        Entity* GetEntity(b2Fixture& fixture) const;
+
+        /**
+         * Reports all colliders overlapping a shape.
+         *
+         * @param shape     the shape to test
+         * @param xf        the transform of the shape
+         * @param filter    selects the colliders to consider
+         * @param listener  receives the colliders found
+         */
+        void QueryOverlap(const b2Shape& shape, const b2Transform& xf, const QueryFilter& filter, OverlapListener& listener) const;
+
+        /**
+         * Sweeps a shape and determines the first impact.
+         *
+         * @param shape         the shape to sweep
+         * @param xf            the start transform of the shape
+         * @param translation   the translation of the sweep
+         * @param rotation      the rotation of the sweep
+         * @param filter        selects the colliders to consider
+         * @param hit           receives the first impact
+         * @return `true` if the shape hits a collider
+         */
+        bool QuerySweep(const b2Shape& shape, const b2Transform& xf, const Vector2f& translation, float rotation, const QueryFilter& filter, SweepHit& hit) const;
+
+        /**
+         * Publishes collision signals for recorded begin contact events.
+         */
+        void DispatchCollisionSignals();
+
         // Inherited via BaseService
         virtual void OnStartup() override;
         virtual void OnShutdown() override;
@@ -158,6 +1780,9 @@ namespace astu::suite2d {
         virtual void OnEntityRemoved(std::shared_ptr<Entity> entity) override;
 
         friend class ContactListener;
+        friend class CBox2DBody;
+        friend class ColliderChanges;
+        friend class Box2DWorldGroup;
     };
 
 } // end of namespace
\ No newline at end of file
@@ -0,0 +1,146 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+#pragma once
+
+// AST-Utilities includes
+#include <Suite2D/CColliders.h>
+
+// C++ Standard Library includes
+#include <cstdint>
+
+namespace astu {
+
+    // Forward declaration
+    class Entity;
+
+}
+
+namespace astu::suite2d {
+
+    /**
+     * Describes a ray to be cast into the physics world.
+     *
+     * The ray only hits colliders which category bits match the mask bits
+     * of the ray and which mask bits match the category bits of the ray.
+     */
+    struct RayCastQuery {
+
+        /** The start point of the ray in world coordinates. */
+        Vector2f from;
+
+        /** The end point of the ray in world coordinates. */
+        Vector2f to;
+
+        /** The category bits of the ray. */
+        uint16_t categoryBits = 0x0001;
+
+        /** The mask bits of the ray. */
+        uint16_t maskBits = 0xffff;
+    };
+
+    /**
+     * The closest hit of a ray.
+     */
+    struct RayCastHit {
+
+        /** The entity hit by the ray, `nullptr` if nothing has been hit. */
+        Entity* entity;
+
+        /** The collider hit by the ray, `nullptr` if nothing has been hit. */
+        CBodyCollider* collider;
+
+        /** The sub-collider hit by the ray, equals the collider unless it is a compound. */
+        CBodyCollider* subCollider;
+
+        /** The point of intersection in world coordinates. */
+        Vector2f point;
+
+        /** The surface normal at the point of intersection. */
+        Vector2f normal;
+
+        /** The fraction along the ray at the point of intersection. */
+        float fraction;
+    };
+
+    /**
+     * Selects the colliders considered by overlap and sweep queries.
+     *
+     * A collider is considered if its category bits match the mask bits
+     * of the filter and its mask bits match the category bits of the
+     * filter.
+     */
+    struct QueryFilter {
+
+        /** The category bits of the query. */
+        uint16_t categoryBits = 0x0001;
+
+        /** The mask bits of the query. */
+        uint16_t maskBits = 0xffff;
+
+        /** Whether sensor colliders are considered. */
+        bool includeSensors = false;
+    };
+
+    /**
+     * A collider found by an overlap query.
+     */
+    struct OverlapHit {
+
+        /** The entity owning the collider. */
+        Entity* entity;
+
+        /** The overlapping collider. */
+        CBodyCollider* collider;
+
+        /** The overlapping sub-collider, equals the collider unless it is a compound. */
+        CBodyCollider* subCollider;
+    };
+
+    /**
+     * Interface for receivers of overlap query results.
+     */
+    class OverlapListener {
+    public:
+
+        /** Virtual destructor. */
+        virtual ~OverlapListener() {}
+
+        /**
+         * Called for each overlapping collider.
+         *
+         * @param hit   the overlapping collider
+         * @return `true` to continue the query, `false` to terminate it
+         */
+        virtual bool OnOverlap(const OverlapHit& hit) = 0;
+    };
+
+    /**
+     * The first collider hit by a sweep query.
+     */
+    struct SweepHit {
+
+        /** The entity hit, `nullptr` if nothing has been hit. */
+        Entity* entity;
+
+        /** The collider hit, `nullptr` if nothing has been hit. */
+        CBodyCollider* collider;
+
+        /** The sub-collider hit, equals the collider unless it is a compound. */
+        CBodyCollider* subCollider;
+
+        /** The point of impact in world coordinates. */
+        Vector2f point;
+
+        /** The surface normal at the point of impact. */
+        Vector2f normal;
+
+        /** The fraction of the sweep at the time of impact. */
+        float fraction;
+    };
+
+} // end of namespace
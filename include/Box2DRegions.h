@@ -0,0 +1,53 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+#pragma once
+
+// AST-Utilities includes
+#include <Math/Vector2.h>
+
+namespace astu::suite2d {
+
+    /**
+     * A circular area of interest, e.g., the surroundings of a player.
+     *
+     * Non-static bodies outside of all interest regions become dormant.
+     */
+    struct InterestRegion {
+
+        /** The center of the region in world coordinates. */
+        Vector2f center;
+
+        /** The radius of the region. */
+        float radius;
+    };
+
+    /**
+     * Determines how bodies outside of all interest regions are treated.
+     */
+    enum class RegionMode {
+
+        /**
+         * Dormant bodies are forced asleep.
+         *
+         * Sleeping bodies keep their contacts and broad-phase proxies but
+         * lose their velocities. Bodies which have been awake are woken up
+         * once they are inside an interest region again.
+         */
+        Sleep,
+
+        /**
+         * Dormant bodies are disabled.
+         *
+         * Disabled bodies are removed from the broad-phase and keep their
+         * velocities, which get resumed once they are inside an interest
+         * region again. Other bodies pass through disabled bodies.
+         */
+        Disable,
+    };
+
+} // end of namespace
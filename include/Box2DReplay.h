@@ -0,0 +1,72 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+#pragma once
+
+// C++ Standard Library includes
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace astu::suite2d {
+
+    /**
+     * The outcome of replaying a recording.
+     */
+    struct ReplayResult {
+
+        /** The number of steps replayed. */
+        int numSteps = 0;
+
+        /** Whether the replayed state differs from the recorded state. */
+        bool diverged = false;
+
+        /** The index of the first diverging step, -1 if none diverged. */
+        int divergingStep = -1;
+
+        /** The recorded state hash of the first diverging step. */
+        uint64_t recordedHash = 0;
+
+        /** The replayed state hash of the first diverging step. */
+        uint64_t replayedHash = 0;
+    };
+
+    /**
+     * Replays recordings of the Box2D physics system headless.
+     *
+     * Recordings are created by `Box2DPhysicsSystem::StartRecording`. The
+     * replayer rebuilds the world from the recorded inputs without any
+     * entities or services and compares the state hash after each step
+     * with the recorded one. Recordings are only expected to replay
+     * identically using the same build of Box2D on the same platform.
+     */
+    class Box2DReplayer {
+    public:
+
+        /**
+         * Constructor, loads a recording.
+         *
+         * @param filename  the name of the recording file
+         * @throws std::runtime_error in case the file cannot be read
+         */
+        explicit Box2DReplayer(const std::string& filename);
+
+        /**
+         * Replays the recording.
+         *
+         * @param stopOnDivergence  whether to stop at the first diverging step
+         * @return the outcome of the replay
+         * @throws std::runtime_error in case the recording is malformed
+         */
+        ReplayResult Run(bool stopOnDivergence = true) const;
+
+    private:
+        /** The content of the recording file. */
+        std::vector<uint8_t> data;
+    };
+
+} // end of namespace
@@ -0,0 +1,83 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+#pragma once
+
+// C++ Standard Library includes
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace astu::suite2d {
+
+    // Forward declaration
+    class Box2DPhysicsSystem;
+
+    /**
+     * Binary snapshot of the state of a physics world.
+     *
+     * Snapshots contain poses, velocities and sleep states of all
+     * non-static bodies as well as the warm-starting impulses of touching
+     * contacts. Bodies are identified by the identity of their entities,
+     * hence snapshots are only meaningful within the process which has
+     * created them. Snapshots can be reused, their memory is retained.
+     */
+    class PhysicsSnapshot {
+    public:
+
+        /**
+         * Returns the size of this snapshot.
+         *
+         * @return the size in bytes
+         */
+        size_t Size() const {
+            return data.size();
+        }
+
+        /**
+         * Returns the binary data of this snapshot.
+         *
+         * @return the binary data
+         */
+        const uint8_t* Data() const {
+            return data.data();
+        }
+
+        /**
+         * Replaces the content of this snapshot.
+         *
+         * @param bytes the binary data
+         * @param size  the size in bytes
+         */
+        void Assign(const uint8_t* bytes, size_t size) {
+            data.assign(bytes, bytes + size);
+        }
+
+        /**
+         * Returns whether this snapshot is empty.
+         *
+         * @return `true` if this snapshot is empty
+         */
+        bool IsEmpty() const {
+            return data.empty();
+        }
+
+        /**
+         * Removes the content of this snapshot, retaining its memory.
+         */
+        void Clear() {
+            data.clear();
+        }
+
+    private:
+        /** The binary data. */
+        std::vector<uint8_t> data;
+
+        friend class Box2DPhysicsSystem;
+    };
+
+} // end of namespace
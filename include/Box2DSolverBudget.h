@@ -0,0 +1,73 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+#pragma once
+
+namespace astu::suite2d {
+
+    /**
+     * The time budget and the lower quality bounds of the adaptive solver.
+     *
+     * The upper bounds are the iterations, continuous physics setting and
+     * maximum number of sub-steps configured at the physics system.
+     */
+    struct SolverBudget {
+
+        /** The time budget per step in milliseconds. */
+        double stepTime = 2.0;
+
+        /** The minimum number of velocity iterations. */
+        int minVelocityIterations = 3;
+
+        /** The minimum number of position iterations. */
+        int minPositionIterations = 1;
+
+        /** Whether continuous collision may be turned off. */
+        bool allowDiscrete = true;
+
+        /** The minimum number of sub-steps per update. */
+        int minSubSteps = 1;
+
+        /**
+         * The fraction below the budget required to raise the quality.
+         *
+         * Prevents oscillating between two levels whose step times lie
+         * just above and below the budget.
+         */
+        float hysteresis = 0.25f;
+
+        /** The number of steps to measure before the next adjustment. */
+        int settleSteps = 10;
+    };
+
+    /**
+     * The solver settings chosen by the adaptive solver.
+     *
+     * Quality is traded for time in the following order: velocity
+     * iterations, position iterations, continuous collision and finally
+     * the maximum number of sub-steps per update, the latter only for
+     * fixed-timestep simulation.
+     */
+    struct SolverLevel {
+
+        /** The quality level, zero is the configured quality. */
+        int level = 0;
+
+        /** The number of velocity iterations. */
+        int velocityIterations = 0;
+
+        /** The number of position iterations. */
+        int positionIterations = 0;
+
+        /** Whether continuous collision is enabled. */
+        bool continuousPhysics = true;
+
+        /** The maximum number of sub-steps per update. */
+        int maxSubSteps = 0;
+    };
+
+} // end of namespace
@@ -0,0 +1,126 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+#pragma once
+
+// Local includes
+#include "Box2DSolverBudget.h"
+
+// C++ Standard Library includes
+#include <cstddef>
+
+namespace astu::suite2d {
+
+    /**
+     * Statistics of the last update performed by a physics system.
+     *
+     * Counts are always available, timings are only measured while
+     * profiling is enabled.
+     */
+    struct StepStats {
+
+        /** The number of bodies in the world. */
+        size_t bodyCount = 0;
+
+        /** The number of non-static bodies awake after the last step. */
+        size_t awakeBodyCount = 0;
+
+        /** The number of bodies outside of all interest regions. */
+        size_t dormantBodyCount = 0;
+
+        /** The number of contacts in the world. */
+        size_t contactCount = 0;
+
+        /** The number of contact events recorded. */
+        size_t contactEventCount = 0;
+
+        /** The number of impact events recorded. */
+        size_t impactEventCount = 0;
+
+        /** The number of steps performed during the last update. */
+        int numSteps = 0;
+
+        /** The solver settings used for the last step. */
+        SolverLevel solver;
+
+        /** The time spent on the complete update in milliseconds. */
+        double updateTime = 0;
+
+        /** The time spent creating and destroying pending bodies in milliseconds. */
+        double spawnTime = 0;
+
+        /** The time spent pushing poses to Box2D in milliseconds. */
+        double collectTime = 0;
+
+        /** The time spent stepping the world in milliseconds. */
+        double stepTime = 0;
+
+        /** The time Box2D spent on narrow-phase collision in milliseconds. */
+        double collideTime = 0;
+
+        /** The time Box2D spent on the constraint solver in milliseconds. */
+        double solveTime = 0;
+
+        /** The time Box2D spent on the broad-phase in milliseconds. */
+        double broadphaseTime = 0;
+
+        /** The time Box2D spent on continuous collision in milliseconds. */
+        double solveTOITime = 0;
+
+        /** The time spent writing poses back to the entities in milliseconds. */
+        double deployTime = 0;
+
+        /** The time spent publishing collision signals in milliseconds. */
+        double dispatchTime = 0;
+    };
+
+    /**
+     * The timings which can be summarized over the profiling window.
+     */
+    enum class ProfileMetric {
+        Update,
+        Spawn,
+        Collect,
+        Step,
+        Collide,
+        Solve,
+        Broadphase,
+        SolveTOI,
+        Deploy,
+        Dispatch,
+    };
+
+    /**
+     * Summary of a timing over the updates of the profiling window.
+     *
+     * All values are in milliseconds.
+     */
+    struct ProfileSummary {
+
+        /** The number of updates summarized. */
+        size_t numSamples = 0;
+
+        /** The minimum. */
+        double min = 0;
+
+        /** The arithmetic mean. */
+        double mean = 0;
+
+        /** The maximum. */
+        double max = 0;
+
+        /** The median. */
+        double p50 = 0;
+
+        /** The 95th percentile. */
+        double p95 = 0;
+
+        /** The 99th percentile. */
+        double p99 = 0;
+    };
+
+} // end of namespace
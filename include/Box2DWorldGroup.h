@@ -0,0 +1,158 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+#pragma once
+
+// AST-Utilities includes
+#include <Service/Service.h>
+#include <Service/UpdateService.h>
+
+// C++ Standard Library includes
+#include <memory>
+#include <vector>
+
+namespace astu::suite2d {
+
+    // Forward declaration
+    class Box2DPhysicsSystem;
+    class WorkerPool;
+
+    /**
+     * Steps a group of independent physics systems concurrently.
+     *
+     * A single Box2D world is simulated by one thread only. This service
+     * takes over the update of its physics systems and simulates their
+     * worlds in parallel. Poses are collected from and deployed to the
+     * entities on the updating thread, before and after all worlds have
+     * been stepped. Worlds are handed out largest first, based on their
+     * number of bodies and contacts, to balance the load among threads.
+     *
+     * The physics systems must not share any state with each other,
+     * e.g., collision listeners of different systems must not access
+     * common data while the worlds are stepped.
+     *
+     * Box2D itself keeps some global state. The contact factories are
+     * built before the first parallel step. The global counters of the
+     * distance and time-of-impact functions (`b2_gjkCalls`, `b2_toiCalls`,
+     * etc.) are updated by all worlds without synchronization, hence
+     * their values are unreliable while worlds are stepped in parallel and
+     * thread sanitizers report data races on them. Neither Box2D nor this
+     * library reads these counters.
+     */
+    class Box2DWorldGroup 
+        : public BaseService
+        , private Updatable
+    {
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param updatePriority    the priority used to update this group
+         */
+        Box2DWorldGroup(int updatePriority = Priority::Normal);
+
+        /**
+         * Virtual destructor.
+         */
+        virtual ~Box2DWorldGroup();
+
+        /**
+         * Sets the number of additional threads used to step the worlds.
+         *
+         * Zero means that all worlds are stepped by the updating thread.
+         *
+         * @param n the number of worker threads
+         * @return reference to this group for method chaining
+         */
+        Box2DWorldGroup& SetWorkerThreads(unsigned int n);
+
+        /**
+         * Returns the number of additional threads used to step the worlds.
+         *
+         * @return the number of worker threads
+         */
+        unsigned int GetWorkerThreads() const {
+            return workerThreads;
+        }
+
+        /**
+         * Adds a physics system to this group.
+         *
+         * The physics system is no longer updated on its own, but stepped
+         * by this group.
+         *
+         * @param system    the physics system to add
+         * @throws std::logic_error in case the system already belongs to a group or steps asynchronously
+         */
+        void AddWorld(std::shared_ptr<Box2DPhysicsSystem> system);
+
+        /**
+         * Removes a physics system from this group.
+         *
+         * The physics system is updated on its own again.
+         *
+         * @param system    the physics system to remove
+         */
+        void RemoveWorld(std::shared_ptr<Box2DPhysicsSystem> system);
+
+        /**
+         * Returns the number of physics systems of this group.
+         *
+         * @return the number of physics systems
+         */
+        size_t NumWorlds() const {
+            return worlds.size();
+        }
+
+        /**
+         * Returns a physics system of this group.
+         *
+         * The statistics of the last update of each world are available
+         * via `Box2DPhysicsSystem::GetStepStats`.
+         *
+         * @param idx   the index of the physics system
+         * @return the physics system
+         */
+        Box2DPhysicsSystem& GetWorld(size_t idx) {
+            return *worlds[idx];
+        }
+
+        /**
+         * Returns the time spent stepping all worlds during the last update.
+         *
+         * @return the wall-clock time in milliseconds
+         */
+        double GetStepTime() const {
+            return stepTime;
+        }
+
+    private:
+        /** The physics systems of this group. */
+        std::vector<std::shared_ptr<Box2DPhysicsSystem>> worlds;
+
+        /** The physics systems being stepped, ordered by estimated cost. */
+        std::vector<Box2DPhysicsSystem*> schedule;
+
+        /** The number of additional threads used to step the worlds. */
+        unsigned int workerThreads;
+
+        /** Used to step the worlds in parallel. */
+        std::unique_ptr<WorkerPool> workerPool;
+
+        /** The time spent stepping all worlds during the last update. */
+        double stepTime;
+
+        // Inherited via BaseService
+        virtual void OnStartup() override;
+        virtual void OnShutdown() override;
+
+        // Inherited via Updatable
+        virtual void OnUpdate() override;
+    };
+
+} // end of namespace
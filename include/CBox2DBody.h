@@ -10,11 +10,20 @@
 // AST-Utilities includes
 #include <Suite2D/CBody.h>
 
+// C++ Standard Library includes
+#include <cstdint>
+
  // Forward declaration
 class b2Body;
 
 namespace astu::suite2d {
 
+    // Forward declaration
+    class Box2DPhysicsSystem;
+    class BindingTable;
+    enum class RecordTag : uint8_t;
+    struct CommandBuffer;
+
     class CBox2DBody : public CBody {
     public:
 
@@ -23,6 +32,38 @@ namespace astu::suite2d {
          */
         CBox2DBody()
             : boxBody(nullptr)
+            , system(nullptr)
+            , bindingIndex(-1)
+            , awake(true)
+            , sleepingAllowed(true)
+            , enabled(true)
+            , pendingChanges(0)
+            , pendingForce(0, 0)
+            , pendingTorque(0)
+            , pendingBuffer(nullptr)
+            , pendingSlot(0)
+        {
+            // Intentionally left empty.
+        }
+
+        /**
+         * Copy constructor, the copy is not bound to a Box2D body.
+         *
+         * @param o the body to copy
+         */
+        CBox2DBody(const CBox2DBody& o)
+            : CBody(o)
+            , boxBody(nullptr)
+            , system(nullptr)
+            , bindingIndex(-1)
+            , awake(o.awake)
+            , sleepingAllowed(o.sleepingAllowed)
+            , enabled(o.enabled)
+            , pendingChanges(0)
+            , pendingForce(0, 0)
+            , pendingTorque(0)
+            , pendingBuffer(nullptr)
+            , pendingSlot(0)
         {
             // Intentionally left empty.
         }
@@ -52,11 +93,166 @@ namespace astu::suite2d {
         virtual Vector2f GetLocalPoint(float wpx, float wpy) override;
         virtual void ApplyForce(const Vector2f& force) override;
 
+        /**
+         * Wakes this body up or puts it to sleep.
+         *
+         * Sleeping bodies lose their velocities. Bodies outside of all
+         * interest regions of the physics system might be put to sleep
+         * again with the next update.
+         *
+         * @param b `true` to wake this body up
+         */
+        void SetAwake(bool b);
+
+        /**
+         * Returns whether this body is awake.
+         *
+         * @return `true` if this body is awake
+         */
+        bool IsAwake() const;
+
+        /**
+         * Specifies whether this body is allowed to fall asleep.
+         *
+         * @param b `true` to allow sleeping
+         */
+        void SetSleepingAllowed(bool b);
+
+        /**
+         * Returns whether this body is allowed to fall asleep.
+         *
+         * @return `true` if sleeping is allowed
+         */
+        bool IsSleepingAllowed() const {
+            return sleepingAllowed;
+        }
+
+        /**
+         * Enables or disables this body.
+         *
+         * Disabled bodies do not take part in collision detection and
+         * simulation. Bodies disabled by the physics system because they
+         * are outside of all interest regions remain disabled until they
+         * are inside a region again.
+         *
+         * @param b `true` to enable this body
+         */
+        void SetEnabled(bool b);
+
+        /**
+         * Returns whether this body is enabled by the application.
+         *
+         * @return `true` if this body is enabled
+         */
+        bool IsEnabled() const {
+            return enabled;
+        }
+
     private:
+        /** The changes which can be pending. */
+        enum Changes : uint16_t {
+            ChangedType = 0x0001,
+            ChangedEnabled = 0x0002,
+            ChangedSleepingAllowed = 0x0004,
+            ChangedLinearDamping = 0x0008,
+            ChangedAngularDamping = 0x0010,
+            ChangedLinearVelocity = 0x0020,
+            ChangedAngularVelocity = 0x0040,
+            ChangedAwake = 0x0080,
+            AppliedForce = 0x0100,
+            AppliedTorque = 0x0200,
+        };
+
         /** The actual Box2D body. */
         b2Body* boxBody;
 
+        /** The physics system this body has been added to. */
+        Box2DPhysicsSystem* system;
+
+        /** The index of this body within the binding table, -1 if unbound. */
+        int bindingIndex;
+
+        /** Whether this body is awake, used until the Box2D body exists. */
+        bool awake;
+
+        /** Whether this body is allowed to fall asleep. */
+        bool sleepingAllowed;
+
+        /** Whether this body is enabled by the application. */
+        bool enabled;
+
+        /** The changes not yet pushed to the Box2D body. */
+        uint16_t pendingChanges;
+
+        /** The accumulated force not yet applied to the Box2D body. */
+        Vector2f pendingForce;
+
+        /** The accumulated torque not yet applied to the Box2D body. */
+        float pendingTorque;
+
+        /** The command buffer listing this body while changes are pending. */
+        CommandBuffer* pendingBuffer;
+
+        /** The index of this body within the command buffer. */
+        size_t pendingSlot;
+
+        /**
+         * Informs the physics system that this body might have been woken up.
+         */
+        void Activate();
+
+        /**
+         * Tests whether the Box2D body must not be accessed.
+         *
+         * This is the case while the world is stepped asynchronously.
+         *
+         * @return `true` if the Box2D body is locked
+         */
+        bool IsLocked() const;
+
+        /**
+         * Marks a change as pending if changes are currently deferred.
+         *
+         * Changes are deferred while the world is stepped asynchronously
+         * or if deferred commands are enabled at the physics system.
+         * Repeated changes of the same kind collapse into one.
+         *
+         * @param change    the change, see Changes
+         * @return `true` if the change is pending
+         */
+        bool Defer(uint16_t change);
+
+        /**
+         * Pushes changes of the component state to the Box2D body.
+         *
+         * Changes are pushed in the order of their flags, regardless of
+         * the order in which they have been issued.
+         *
+         * @param changes   the changes to push, see Changes
+         */
+        void Push(uint16_t changes);
+
+        /**
+         * Pushes all pending changes to the Box2D body.
+         */
+        void ApplyPendingChanges();
+
+        /**
+         * Drops all pending changes, e.g., because the body is destroyed.
+         */
+        void DiscardPendingChanges();
+
+        /**
+         * Records a command issued to this body if the system is recording.
+         *
+         * @param tag   the type of command
+         * @param x     the first argument
+         * @param y     the second argument, if required by the command
+         */
+        void Record(RecordTag tag, float x, float y = 0);
+
         friend class Box2DPhysicsSystem;
+        friend class BindingTable;
     };
 
 } // end of namespace
\ No newline at end of file
@@ -10,10 +10,15 @@
 // AST-Utilities includes
 #include <Suite2D/CColliders.h>
 
+// Local includes
+#include "CChainColliders.h"
+#include "CCompoundCollider.h"
+
 // Box2D includes
 #include <box2d/b2_fixture.h>
 
 // C++ Standard Library includes
+#include <algorithm>
 #include <vector>
 
 // Forward declaration
@@ -21,6 +26,119 @@ class b2Body;
 
 namespace astu::suite2d {
 
+    // Forward declaration
+    class ShapeCache;
+    class Box2DPhysicsSystem;
+    class IBox2DCollider;
+    struct CommandBuffer;
+
+    /**
+     * An entity overlapping a sensor collider.
+     */
+    struct SensorOverlap {
+
+        /** The overlapping entity. */
+        Entity* entity;
+
+        /** The number of touching contacts between the entity and the sensor. */
+        int count;
+    };
+
+    /**
+     * The changes of a collider not yet pushed to its fixtures.
+     *
+     * Changes are deferred under the same conditions as the changes of
+     * bodies, see Box2DPhysicsSystem::SetDeferredCommands. Repeated
+     * changes of the same kind collapse into one, changing the category
+     * and mask bits results in a single update of the filter data.
+     */
+    class ColliderChanges {
+    public:
+
+        /** The changes which can be pending. */
+        enum Flags : uint8_t {
+            Restitution = 0x01,
+            Friction = 0x02,
+            Density = 0x04,
+            Filter = 0x08,
+            Sensor = 0x10,
+        };
+
+        /**
+         * Constructor.
+         */
+        ColliderChanges()
+            : system(nullptr)
+            , flags(0)
+            , buffer(nullptr)
+            , slot(0)
+        {
+            // Intentionally left empty.
+        }
+
+        /**
+         * Copy constructor, pending changes are not copied.
+         */
+        ColliderChanges(const ColliderChanges&) : ColliderChanges() {}
+
+        /**
+         * Sets the physics system owning the fixtures of the collider.
+         *
+         * @param s the physics system, `nullptr` if the collider has no fixtures
+         */
+        void SetSystem(Box2DPhysicsSystem* s) {
+            system = s;
+        }
+
+        /**
+         * Marks a change as pending if changes are currently deferred.
+         *
+         * @param collider  the collider which has been changed
+         * @param change    the change, see Flags
+         * @return `true` if the change is pending
+         */
+        bool Defer(IBox2DCollider& collider, uint8_t change);
+
+        /**
+         * Returns and clears the pending changes.
+         *
+         * @return the pending changes, see Flags
+         */
+        uint8_t Take() {
+            const uint8_t result = flags;
+            flags = 0;
+            buffer = nullptr;
+            return result;
+        }
+
+        /**
+         * Drops all pending changes, e.g., because the fixtures are destroyed.
+         */
+        void Discard();
+
+        /**
+         * Records changed properties of a fixture, if the physics system
+         * owning the fixture is recording.
+         *
+         * @param fixture   the fixture
+         * @param change    the changed properties, see Flags
+         */
+        void Record(const b2Fixture& fixture, uint8_t change) const;
+
+    private:
+        /** The physics system owning the fixtures, `nullptr` if none. */
+        Box2DPhysicsSystem* system;
+
+        /** The pending changes. */
+        uint8_t flags;
+
+        /** The command buffer listing the collider while changes are pending. */
+        CommandBuffer* buffer;
+
+        /** The index of the collider within the command buffer. */
+        size_t slot;
+    };
+
     /**
      * Interface for Box2D colliders.
      */
@@ -31,11 +149,101 @@ namespace astu::suite2d {
         virtual ~IBox2DCollider() {}
 
         /**
-         * Creates a Box2D fixture for the specified body.
+         * Creates the Box2D fixtures for the specified body.
+         * 
+         * @param body  the body for which to create the fixtures
+         * @param cache used to look up cooked shapes
+         */
+        virtual void CreateFixture(b2Body & body, ShapeCache & cache) = 0; 
+
+        /**
+         * Returns the collider component implementing this interface.
          * 
-         * @param body  the body for which to create the fixture
+         * @return the collider component
          */
-        virtual void CreateFixture(b2Body & body) = 0; 
+        virtual CBodyCollider& GetBodyCollider() = 0;
+
+        /**
+         * Returns the collider component added to the entity.
+         *
+         * This is the compound collider for sub-colliders of compounds,
+         * otherwise the collider component implementing this interface.
+         *
+         * @return the collider component added to the entity
+         */
+        virtual CBodyCollider& GetRootCollider() = 0;
+
+        /**
+         * Sets the compound collider this collider belongs to.
+         *
+         * @param owner the compound collider, `nullptr` if none
+         */
+        virtual void SetOwner(IBox2DCollider* owner) = 0;
+
+        /**
+         * Returns the impulse required to report impacts of this collider.
+         * 
+         * Sub-colliders without a threshold of their own use the threshold
+         * of their compound.
+         *
+         * @return the impact threshold, negative if not specified
+         */
+        virtual float GetImpactThreshold() const = 0;
+
+        /**
+         * Specifies whether this collider is a sensor.
+         *
+         * @param b `true` to make this collider a sensor
+         */
+        virtual void SetSensor(bool b) = 0;
+
+        /**
+         * Adds a touching contact with an entity to the overlap set.
+         *
+         * @param entity    the entity touching this sensor
+         * @return `true` if the entity has not overlapped before
+         */
+        virtual bool AddOverlap(Entity& entity) = 0;
+
+        /**
+         * Removes a touching contact with an entity from the overlap set.
+         *
+         * @param entity    the entity no longer touching this sensor
+         * @return `true` if the entity does not overlap anymore
+         */
+        virtual bool RemoveOverlap(Entity& entity) = 0;
+
+        /**
+         * Removes all entities from the overlap set.
+         */
+        virtual void ClearOverlaps() = 0;
+
+        /**
+         * Forgets the Box2D fixtures of this collider.
+         *
+         * Called after the fixtures have been destroyed together with
+         * their body or world.
+         */
+        virtual void ReleaseFixtures() = 0;
+
+        /**
+         * Sets the physics system owning the fixtures of this collider.
+         *
+         * @param system    the physics system
+         */
+        virtual void SetSystem(Box2DPhysicsSystem* system) = 0;
+
+        /**
+         * Pushes all pending changes to the fixtures of this collider.
+         */
+        virtual void ApplyPendingChanges() = 0;
+
+        /**
+         * Returns the Box2D fixture created last for this collider.
+         *
+         * @return the fixture, `nullptr` if this collider has no fixtures
+         */
+        virtual const b2Fixture* GetLastFixture() const = 0;
     };
 
     template <typename T>
@@ -47,6 +255,28 @@ namespace astu::suite2d {
          */
         CBox2DBaseCollider()
             : fixture(nullptr)
+            , numFixtures(0)
+            , impactThreshold(-1)
+            , sensor(false)
+            , owner(nullptr)
+        {
+            // Intentionally left empty            
+        }
+
+        /**
+         * Copy constructor.
+         *
+         * Copies the configuration, fixtures and overlaps are not copied.
+         *
+         * @param o the collider to copy
+         */
+        CBox2DBaseCollider(const CBox2DBaseCollider& o)
+            : T(o)
+            , fixture(nullptr)
+            , numFixtures(0)
+            , impactThreshold(o.impactThreshold)
+            , sensor(o.sensor)
+            , owner(nullptr)
         {
             // Intentionally left empty            
         }
@@ -63,54 +293,266 @@ namespace astu::suite2d {
 
         virtual void SetRestitution(float r) override {
             T::SetRestitution(r);
-            if (fixture) {
-                fixture->SetRestitution(r);
+            if (!changes.Defer(*this, ColliderChanges::Restitution)) {
+                Push(ColliderChanges::Restitution);
             }
         }
 
         virtual void SetFriction(float f) override {
             T::SetFriction(f);
-            if (fixture) {
-                fixture->SetFriction(f);
+            if (!changes.Defer(*this, ColliderChanges::Friction)) {
+                Push(ColliderChanges::Friction);
             }
         }
 
         virtual void SetDensity(float d) override {
             T::SetDensity(d);
-            if (fixture) {
-                fixture->SetDensity(d);
+            if (!changes.Defer(*this, ColliderChanges::Density)) {
+                Push(ColliderChanges::Density);
             }
         }
 
         virtual void SetCategoryBits(uint16_t bits) override {
             T::SetCategoryBits(bits);
-            if (fixture) {
-                auto filterData = fixture->GetFilterData();
-                filterData.categoryBits = bits;
-                fixture->SetFilterData(filterData);
+            if (!changes.Defer(*this, ColliderChanges::Filter)) {
+                Push(ColliderChanges::Filter);
             }
         }
 
         virtual void SetMaskBits(uint16_t bits) override {
             T::SetMaskBits(bits);
-            if (fixture) {
-                auto filterData = fixture->GetFilterData();
-                filterData.maskBits = bits;
-                fixture->SetFilterData(filterData);
+            if (!changes.Defer(*this, ColliderChanges::Filter)) {
+                Push(ColliderChanges::Filter);
+            }
+        }
+
+        /**
+         * Sets the impulse required to report impacts of this collider.
+         * 
+         * Overrides the impact threshold of the physics system, a negative
+         * value means that the threshold of the physics system is used.
+         * The threshold of a compound applies to its sub-colliders which
+         * do not specify a threshold of their own.
+         * 
+         * @param threshold the impact threshold
+         */
+        void SetImpactThreshold(float threshold) {
+            impactThreshold = threshold;
+        }
+
+        /**
+         * Specifies whether this collider is a sensor.
+         *
+         * Sensors detect overlapping colliders but never collide, hence
+         * they only cost broad-phase and overlap tests. Should be
+         * specified before this collider is added to an entity, changing
+         * it afterwards only affects contacts which begin later and clears
+         * the overlap set. Setting it for a compound applies it to all
+         * sub-colliders.
+         *
+         * @param b `true` to make this collider a sensor
+         */
+        virtual void SetSensor(bool b) override {
+            if (b == sensor) {
+                return;
+            }
+            sensor = b;
+            if (!changes.Defer(*this, ColliderChanges::Sensor)) {
+                Push(ColliderChanges::Sensor);
+            }
+        }
+
+        /**
+         * Returns whether this collider is a sensor.
+         *
+         * @return `true` if this collider is a sensor
+         */
+        bool IsSensor() const {
+            return sensor;
+        }
+
+        /**
+         * Returns the entities currently overlapping this sensor.
+         *
+         * The overlap set is updated incrementally from begin and end
+         * contacts at the end of each update of the physics system.
+         *
+         * @return the overlapping entities
+         */
+        const std::vector<SensorOverlap>& GetOverlaps() const {
+            return overlaps;
+        }
+
+        /**
+         * Tests whether an entity overlaps this sensor.
+         *
+         * @param entity    the entity to test
+         * @return `true` if the entity overlaps this sensor
+         */
+        bool IsOverlapping(const Entity& entity) const {
+            return std::any_of(overlaps.begin(), overlaps.end(), 
+                [&entity](const SensorOverlap& o) { return o.entity == &entity; });
+        }
+
+        // Inherited via IBox2DCollider
+        virtual CBodyCollider& GetBodyCollider() override {
+            return *this;
+        }
+
+        virtual CBodyCollider& GetRootCollider() override {
+            return owner ? owner->GetRootCollider() : *this;
+        }
+
+        virtual void SetOwner(IBox2DCollider* compound) override {
+            owner = compound;
+        }
+
+        virtual bool AddOverlap(Entity& entity) override {
+            for (auto& o : overlaps) {
+                if (o.entity == &entity) {
+                    ++o.count;
+                    return false;
+                }
             }
+            overlaps.push_back({&entity, 1});
+            return true;
+        }
+
+        virtual bool RemoveOverlap(Entity& entity) override {
+            for (auto& o : overlaps) {
+                if (o.entity == &entity) {
+                    if (--o.count > 0) {
+                        return false;
+                    }
+                    o = overlaps.back();
+                    overlaps.pop_back();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        virtual void ClearOverlaps() override {
+            overlaps.clear();
+        }
+
+        virtual void ReleaseFixtures() override {
+            fixture = nullptr;
+            numFixtures = 0;
+            changes.Discard();
+            changes.SetSystem(nullptr);
+        }
+
+        virtual void SetSystem(Box2DPhysicsSystem* system) override {
+            changes.SetSystem(system);
+        }
+
+        virtual void ApplyPendingChanges() override {
+            Push(changes.Take());
+        }
+
+        virtual const b2Fixture* GetLastFixture() const override {
+            return fixture;
+        }
+
+        virtual float GetImpactThreshold() const override {
+            if (impactThreshold < 0 && owner) {
+                return owner->GetImpactThreshold();
+            }
+            return impactThreshold;
         }
 
     protected:
-        /** The Box2D fixture. */
+        /** The Box2D fixture created last for this collider. */
         b2Fixture* fixture;
 
+        /** The number of Box2D fixtures created for this collider. */
+        int numFixtures;
+
+        /** The impulse required to report impacts, negative if unspecified. */
+        float impactThreshold;
+
+        /** Whether this collider is a sensor. */
+        bool sensor;
+
+        /** The entities overlapping this sensor. */
+        std::vector<SensorOverlap> overlaps;
+
+        /** The compound collider this collider belongs to, `nullptr` if none. */
+        IBox2DCollider* owner;
+
+        /** The changes not yet pushed to the fixtures. */
+        ColliderChanges changes;
+
         void ConfigureFixtureDef(b2FixtureDef& fixtureDef) {
             fixtureDef.restitution = T::GetRestitution();
             fixtureDef.friction = T::GetFriction();
             fixtureDef.density = T::GetDensity();
             fixtureDef.filter.categoryBits = T::GetCategoryBits();
             fixtureDef.filter.maskBits = T::GetMaskBits();
-            fixtureDef.userData.pointer = reinterpret_cast<uintptr_t>(this);
+            fixtureDef.isSensor = sensor;
+            fixtureDef.userData.pointer = 
+                reinterpret_cast<uintptr_t>(static_cast<IBox2DCollider*>(this));
+        }
+
+        /**
+         * Pushes changes of the collider configuration to its fixtures.
+         *
+         * @param c the changes to push, see ColliderChanges::Flags
+         */
+        void Push(uint8_t c) {
+            if (!c) {
+                return;
+            }
+
+            const float restitution = T::GetRestitution();
+            const float friction = T::GetFriction();
+            const float density = T::GetDensity();
+            const uint16_t categoryBits = T::GetCategoryBits();
+            const uint16_t maskBits = T::GetMaskBits();
+            if (c & ColliderChanges::Sensor) {
+                overlaps.clear();
+            }
+
+            ForEachFixture([=](b2Fixture& fx) {
+                if (c & ColliderChanges::Restitution) {
+                    fx.SetRestitution(restitution);
+                }
+                if (c & ColliderChanges::Friction) {
+                    fx.SetFriction(friction);
+                }
+                if (c & ColliderChanges::Density) {
+                    fx.SetDensity(density);
+                }
+                if (c & ColliderChanges::Filter) {
+                    // Each update of the filter data flags the contacts for refiltering.
+                    auto filterData = fx.GetFilterData();
+                    filterData.categoryBits = categoryBits;
+                    filterData.maskBits = maskBits;
+                    fx.SetFilterData(filterData);
+                }
+                if (c & ColliderChanges::Sensor) {
+                    fx.SetSensor(sensor);
+                }
+                changes.Record(fx, c);
+            });
+        }
+
+        /**
+         * Calls a function for each fixture created for this collider.
+         *
+         * Box2D prepends new fixtures to the fixture list of the body,
+         * hence the fixtures of this collider precede the fixture created
+         * last.
+         *
+         * @param func  the function to call
+         */
+        template <typename F>
+        void ForEachFixture(F func) {
+            b2Fixture* f = fixture;
+            for (int i = 0; i < numFixtures && f; ++i, f = f->GetNext()) {
+                func(*f);
+            }
         }
     };
 
@@ -132,7 +574,7 @@ namespace astu::suite2d {
         }
 
         // Inherited via IBox2DCollider
-        virtual void CreateFixture(b2Body & body) override;
+        virtual void CreateFixture(b2Body & body, ShapeCache & cache) override;
     };
 
     class CBox2DPolygonCollider : public CBox2DBaseCollider<CPolygonCollider> {
@@ -153,12 +595,114 @@ namespace astu::suite2d {
         }
 
         // Inherited via IBox2DCollider
-        virtual void CreateFixture(b2Body & body) override;
+        virtual void CreateFixture(b2Body & body, ShapeCache & cache) override;
+    };
 
-    private:
-        /** Used to create Box2D polygon shapes. */
-        static std::vector<b2Vec2> tempVertices;
+    class CBox2DChainCollider : public CBox2DBaseCollider<CChainCollider> {
+    public:
+
+        /**
+         * Constructor.
+         */
+        CBox2DChainCollider()
+        {
+            // Intentionally left empty.
+        }
+
+        // Inherited via CChainCollider
+        virtual std::shared_ptr<EntityComponent> Clone() override {
+            // Create copy using copy-constructor.
+            return std::make_shared<CBox2DChainCollider>(*this);
+        }
+
+        // Inherited via IBox2DCollider
+        virtual void CreateFixture(b2Body & body, ShapeCache & cache) override;
+    };
+
+    class CBox2DEdgeCollider : public CBox2DBaseCollider<CEdgeCollider> {
+    public:
+
+        /**
+         * Constructor.
+         */
+        CBox2DEdgeCollider()
+        {
+            // Intentionally left empty.
+        }
+
+        // Inherited via CEdgeCollider
+        virtual std::shared_ptr<EntityComponent> Clone() override {
+            // Create copy using copy-constructor.
+            return std::make_shared<CBox2DEdgeCollider>(*this);
+        }
+
+        // Inherited via IBox2DCollider
+        virtual void CreateFixture(b2Body & body, ShapeCache & cache) override;
     };
 
+    class CBox2DCompoundCollider : public CBox2DBaseCollider<CCompoundCollider> {
+    public:
+
+        /**
+         * Constructor.
+         */
+        CBox2DCompoundCollider()
+        {
+            // Intentionally left empty.
+        }
+
+        // Inherited via CCompoundCollider
+        virtual std::shared_ptr<EntityComponent> Clone() override;
+
+        virtual void SetRestitution(float r) override {
+            CBox2DBaseCollider::SetRestitution(r);
+            for (auto& col : colliders) {
+                col->SetRestitution(r);
+            }
+        }
+
+        virtual void SetFriction(float f) override {
+            CBox2DBaseCollider::SetFriction(f);
+            for (auto& col : colliders) {
+                col->SetFriction(f);
+            }
+        }
+
+        virtual void SetDensity(float d) override {
+            CBox2DBaseCollider::SetDensity(d);
+            for (auto& col : colliders) {
+                col->SetDensity(d);
+            }
+        }
+
+        virtual void SetCategoryBits(uint16_t bits) override {
+            CBox2DBaseCollider::SetCategoryBits(bits);
+            for (auto& col : colliders) {
+                col->SetCategoryBits(bits);
+            }
+        }
+
+        virtual void SetMaskBits(uint16_t bits) override {
+            CBox2DBaseCollider::SetMaskBits(bits);
+            for (auto& col : colliders) {
+                col->SetMaskBits(bits);
+            }
+        }
+
+        virtual void SetSensor(bool b) override {
+            CBox2DBaseCollider::SetSensor(b);
+            for (auto& col : colliders) {
+                if (auto boxCol = dynamic_cast<IBox2DCollider*>(col.get())) {
+                    boxCol->SetSensor(b);
+                }
+            }
+        }
+
+        // Inherited via IBox2DCollider
+        virtual void CreateFixture(b2Body & body, ShapeCache & cache) override;
+        virtual void ClearOverlaps() override;
+        virtual void ReleaseFixtures() override;
+        virtual void SetSystem(Box2DPhysicsSystem* system) override;
+    };
 
-} // end of namespace
\ No newline at end of file
+} // end of namespace
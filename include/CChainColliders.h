@@ -0,0 +1,216 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+#pragma once
+
+// AST-Utilities includes
+#include <Suite2D/CColliders.h>
+
+// C++ Standard Library includes
+#include <memory>
+#include <vector>
+
+namespace astu::suite2d {
+
+    /**
+     * Collider made of a polyline, either open or closed.
+     *
+     * Chain colliders are meant for static geometry like level outlines
+     * or terrain. Collisions are smoothed across the edges of the chain,
+     * objects do not get caught at the joints between edges.
+     *
+     * Chains are one-sided, collisions are detected on the right side of
+     * each edge. Counter-clockwise loops collide on the outside, clockwise
+     * loops on the inside.
+     *
+     * Consecutive vertices, including the last and first vertex of loops,
+     * must be further apart than the linear slop of the physics engine,
+     * otherwise creating the body fails.
+     */
+    class CChainCollider : public CBodyCollider {
+    public:
+
+        /**
+         * Constructor.
+         */
+        CChainCollider() : loop(false) {}
+
+        /**
+         * Adds a vertex to this chain.
+         *
+         * @param x the x-coordinate of the vertex
+         * @param y the y-coordinate of the vertex
+         * @return reference to this collider for method chaining
+         */
+        CChainCollider& AddVertex(float x, float y) {
+            vertices.push_back(Vector2f(x, y));
+            return *this;
+        }
+
+        /**
+         * Sets the vertices of this chain.
+         *
+         * @param vtx   the vertices
+         * @return reference to this collider for method chaining
+         */
+        CChainCollider& SetVertices(const std::vector<Vector2f>& vtx) {
+            vertices = vtx;
+            return *this;
+        }
+
+        /**
+         * Returns the vertices of this chain.
+         *
+         * @return the vertices
+         */
+        const std::vector<Vector2f>& GetVertices() const {
+            return vertices;
+        }
+
+        /**
+         * Specifies whether the last vertex connects to the first one.
+         *
+         * @param b `true` to close the chain
+         * @return reference to this collider for method chaining
+         */
+        CChainCollider& SetLoop(bool b) {
+            loop = b;
+            return *this;
+        }
+
+        /**
+         * Returns whether the last vertex connects to the first one.
+         *
+         * @return `true` if the chain is closed
+         */
+        bool IsLoop() const {
+            return loop;
+        }
+
+    protected:
+        /** The vertices of this chain. */
+        std::vector<Vector2f> vertices;
+
+        /** Whether the last vertex connects to the first one. */
+        bool loop;
+    };
+
+    /**
+     * Collider made of a single line segment.
+     *
+     * If ghost vertices are specified, the edge is one-sided and
+     * collisions are smoothed with the adjacent edges.
+     */
+    class CEdgeCollider : public CBodyCollider {
+    public:
+
+        /**
+         * Constructor.
+         */
+        CEdgeCollider() 
+            : v0(0, 0), v1(0, 0), v2(0, 0), v3(0, 0), oneSided(false) 
+        {
+            // Intentionally left empty.
+        }
+
+        /**
+         * Sets the vertices of this edge, making it two-sided.
+         *
+         * @param a the start vertex
+         * @param b the end vertex
+         * @return reference to this collider for method chaining
+         */
+        CEdgeCollider& SetVertices(const Vector2f& a, const Vector2f& b) {
+            v1 = a;
+            v2 = b;
+            oneSided = false;
+            return *this;
+        }
+
+        /**
+         * Sets the vertices of this edge including ghost vertices.
+         *
+         * The edge is one-sided, collisions are detected on the right
+         * side of the edge only, looking from the start vertex to the end
+         * vertex.
+         *
+         * @param prev  the ghost vertex preceding the edge
+         * @param a     the start vertex
+         * @param b     the end vertex
+         * @param next  the ghost vertex following the edge
+         * @return reference to this collider for method chaining
+         */
+        CEdgeCollider& SetVertices(const Vector2f& prev, const Vector2f& a, const Vector2f& b, const Vector2f& next) {
+            v0 = prev;
+            v1 = a;
+            v2 = b;
+            v3 = next;
+            oneSided = true;
+            return *this;
+        }
+
+        /**
+         * Returns whether this edge is one-sided.
+         *
+         * @return `true` if ghost vertices have been specified
+         */
+        bool IsOneSided() const {
+            return oneSided;
+        }
+
+    protected:
+        /** The ghost vertex preceding the edge. */
+        Vector2f v0;
+
+        /** The start vertex. */
+        Vector2f v1;
+
+        /** The end vertex. */
+        Vector2f v2;
+
+        /** The ghost vertex following the edge. */
+        Vector2f v3;
+
+        /** Whether this edge is one-sided. */
+        bool oneSided;
+    };
+
+    /**
+     * Interface for factories creating chain collider components.
+     */
+    class CChainColliderFactory {
+    public:
+
+        /** Virtual destructor. */
+        virtual ~CChainColliderFactory() {}
+
+        /**
+         * Creates a new chain collider component.
+         *
+         * @return the newly created component
+         */
+        virtual std::shared_ptr<CChainCollider> CreateChainCollider() = 0;
+    };
+
+    /**
+     * Interface for factories creating edge collider components.
+     */
+    class CEdgeColliderFactory {
+    public:
+
+        /** Virtual destructor. */
+        virtual ~CEdgeColliderFactory() {}
+
+        /**
+         * Creates a new edge collider component.
+         *
+         * @return the newly created component
+         */
+        virtual std::shared_ptr<CEdgeCollider> CreateEdgeCollider() = 0;
+    };
+
+} // end of namespace
@@ -0,0 +1,88 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+#pragma once
+
+// AST-Utilities includes
+#include <Suite2D/CColliders.h>
+
+// C++ Standard Library includes
+#include <memory>
+#include <vector>
+
+namespace astu::suite2d {
+
+    /**
+     * Collider made of several sub-colliders attached to the same body.
+     *
+     * Each sub-collider keeps its own shape, offset, material, filter and
+     * sensor settings. Sub-colliders are not added to the entity, they
+     * must be created by the same physics system as the compound. Their
+     * offsets are relative to the body, the offset of the compound itself
+     * is ignored. Setting the material, filter or sensor flag of the
+     * compound applies it to all sub-colliders. Sub-colliders without an
+     * impact threshold of their own use the threshold of the compound.
+     */
+    class CCompoundCollider : public CBodyCollider {
+    public:
+
+        /**
+         * Adds a sub-collider.
+         *
+         * Sub-colliders must be added before the compound is added to an
+         * entity.
+         *
+         * @param collider  the sub-collider to add
+         * @return reference to this collider for method chaining
+         */
+        CCompoundCollider& AddCollider(std::shared_ptr<CBodyCollider> collider) {
+            colliders.push_back(collider);
+            return *this;
+        }
+
+        /**
+         * Returns the number of sub-colliders.
+         *
+         * @return the number of sub-colliders
+         */
+        size_t NumColliders() const {
+            return colliders.size();
+        }
+
+        /**
+         * Returns a sub-collider.
+         *
+         * @param idx   the index of the sub-collider
+         * @return the sub-collider
+         */
+        CBodyCollider& GetCollider(size_t idx) {
+            return *colliders[idx];
+        }
+
+    protected:
+        /** The sub-colliders. */
+        std::vector<std::shared_ptr<CBodyCollider>> colliders;
+    };
+
+    /**
+     * Interface for factories creating compound collider components.
+     */
+    class CCompoundColliderFactory {
+    public:
+
+        /** Virtual destructor. */
+        virtual ~CCompoundColliderFactory() {}
+
+        /**
+         * Creates a new compound collider component.
+         *
+         * @return the newly created component
+         */
+        virtual std::shared_ptr<CCompoundCollider> CreateCompoundCollider() = 0;
+    };
+
+} // end of namespace
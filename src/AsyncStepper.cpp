@@ -0,0 +1,91 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "AsyncStepper.h"
+
+// C++ Standard Library includes
+#include <cassert>
+
+using namespace std;
+
+namespace astu::suite2d {
+
+    AsyncStepper::AsyncStepper(function<void()> task)
+        : task(move(task))
+        , busy(false)
+        , terminate(false)
+    {
+        worker = thread(&AsyncStepper::WorkerMain, this);
+    }
+
+    AsyncStepper::~AsyncStepper()
+    {
+        {
+            unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [this] { return !busy.load(memory_order_relaxed); });
+            terminate = true;
+        }
+        kicked.notify_one();
+        worker.join();
+    }
+
+    void AsyncStepper::Kick()
+    {
+        {
+            lock_guard<std::mutex> lock(mutex);
+            assert(!busy.load(memory_order_relaxed));
+            busy.store(true, memory_order_relaxed);
+        }
+        kicked.notify_one();
+    }
+
+    void AsyncStepper::Wait()
+    {
+        exception_ptr e;
+        {
+            unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [this] { return !busy.load(memory_order_relaxed); });
+            swap(e, error);
+        }
+
+        if (e) {
+            rethrow_exception(e);
+        }
+    }
+
+    void AsyncStepper::WorkerMain()
+    {
+        while (true) {
+            {
+                unique_lock<std::mutex> lock(mutex);
+                kicked.wait(lock, [this] {
+                    return terminate || busy.load(memory_order_relaxed);
+                });
+
+                if (terminate) {
+                    return;
+                }
+            }
+
+            exception_ptr e;
+            try {
+                task();
+            } catch (...) {
+                e = current_exception();
+            }
+
+            {
+                lock_guard<std::mutex> lock(mutex);
+                error = e;
+                busy.store(false, memory_order_release);
+            }
+            done.notify_all();
+        }
+    }
+
+} // end of namespace
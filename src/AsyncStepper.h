@@ -0,0 +1,100 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+#pragma once
+
+// C++ Standard Library includes
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace astu::suite2d {
+
+    /**
+     * A single worker thread running the same task on request.
+     *
+     * Used to step a physics world while the calling thread carries on
+     * with other work. Exceptions thrown by the task are rethrown by `Wait`.
+     */
+    class AsyncStepper {
+    public:
+
+        /**
+         * Constructor, starts the worker thread.
+         *
+         * @param task  the task to run on each request
+         */
+        explicit AsyncStepper(std::function<void()> task);
+
+        /**
+         * Destructor, waits for the running task and joins the worker thread.
+         */
+        ~AsyncStepper();
+
+        /**
+         * Starts running the task on the worker thread.
+         *
+         * The task must not be running.
+         */
+        void Kick();
+
+        /**
+         * Waits until the task has finished.
+         *
+         * Returns immediately if the task is not running.
+         *
+         * @throws any exception thrown by the task
+         */
+        void Wait();
+
+        /**
+         * Returns whether the task is running.
+         *
+         * If this method returns `false` all effects of the task are
+         * visible to the calling thread.
+         *
+         * @return `true` if the task is running
+         */
+        bool IsBusy() const {
+            return busy.load(std::memory_order_acquire);
+        }
+
+    private:
+        /** The task to run. */
+        std::function<void()> task;
+
+        /** The worker thread. */
+        std::thread worker;
+
+        /** Guards the state of the worker. */
+        std::mutex mutex;
+
+        /** Used to wake up the worker thread. */
+        std::condition_variable kicked;
+
+        /** Used to signal completion of the task. */
+        std::condition_variable done;
+
+        /** Whether the task is running or about to run. */
+        std::atomic<bool> busy;
+
+        /** Whether the worker thread should terminate. */
+        bool terminate;
+
+        /** The exception thrown by the last run of the task. */
+        std::exception_ptr error;
+
+        /**
+         * The main function of the worker thread.
+         */
+        void WorkerMain();
+    };
+
+} // end of namespace
@@ -0,0 +1,146 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "BindingTable.h"
+#include "CBox2DBody.h"
+
+// AST-Utilities includes
+#include <Suite2D/CPose.h>
+
+// C++ Standard Library includes
+#include <cassert>
+
+namespace astu::suite2d {
+
+    void BindingTable::Reserve(size_t n)
+    {
+        bodies.reserve(n);
+        entities.reserve(n);
+        poses.reserve(n);
+        components.reserve(n);
+        types.reserve(n);
+        flags.reserve(n);
+        synced.reserve(n);
+        previous.reserve(n);
+        activeSlots.reserve(n);
+        active.reserve(n);
+    }
+
+    /**
+     * Returns the memory allocated by a vector.
+     */
+    template <typename T>
+    static inline size_t CapacityBytes(const std::vector<T>& v)
+    {
+        return v.capacity() * sizeof(T);
+    }
+
+    size_t BindingTable::GetMemoryUsage() const
+    {
+        return CapacityBytes(bodies)
+            + CapacityBytes(entities)
+            + CapacityBytes(poses)
+            + CapacityBytes(components)
+            + CapacityBytes(types)
+            + CapacityBytes(flags)
+            + CapacityBytes(synced)
+            + CapacityBytes(previous)
+            + CapacityBytes(activeSlots)
+            + CapacityBytes(active);
+    }
+
+    size_t BindingTable::Add(Entity& entity, CBox2DBody& comp, b2Body* body, CPose& pose)
+    {
+        const auto& tx = pose.transform;
+        BodyPose initial{tx.GetTranslationX(), tx.GetTranslationY(), tx.GetRotation()};
+
+        size_t idx = bodies.size();
+        bodies.push_back(body);
+        entities.push_back(&entity);
+        poses.push_back(&pose);
+        components.push_back(&comp);
+        types.push_back(comp.GetType());
+        flags.push_back(0);
+        synced.push_back(initial);
+        previous.push_back(initial);
+        activeSlots.push_back(-1);
+
+        comp.bindingIndex = static_cast<int>(idx);
+        return idx;
+    }
+
+    void BindingTable::Remove(size_t idx)
+    {
+        assert(idx < bodies.size());
+        Deactivate(idx);
+        components[idx]->bindingIndex = -1;
+
+        // Swap with last binding and remove.
+        size_t last = bodies.size() - 1;
+        if (idx != last) {
+            bodies[idx] = bodies[last];
+            entities[idx] = entities[last];
+            poses[idx] = poses[last];
+            components[idx] = components[last];
+            types[idx] = types[last];
+            flags[idx] = flags[last];
+            synced[idx] = synced[last];
+            previous[idx] = previous[last];
+            activeSlots[idx] = activeSlots[last];
+
+            components[idx]->bindingIndex = static_cast<int>(idx);
+            if (activeSlots[idx] >= 0) {
+                active[activeSlots[idx]] = static_cast<int>(idx);
+            }
+        }
+
+        bodies.pop_back();
+        entities.pop_back();
+        poses.pop_back();
+        components.pop_back();
+        types.pop_back();
+        flags.pop_back();
+        synced.pop_back();
+        previous.pop_back();
+        activeSlots.pop_back();
+    }
+
+    void BindingTable::Deactivate(size_t idx)
+    {
+        int slot = activeSlots[idx];
+        if (slot < 0) {
+            return;
+        }
+
+        // Swap with last element and remove.
+        int moved = active.back();
+        active[slot] = moved;
+        activeSlots[moved] = slot;
+        active.pop_back();
+        activeSlots[idx] = -1;
+    }
+
+    void BindingTable::Clear()
+    {
+        for (auto comp : components) {
+            comp->bindingIndex = -1;
+        }
+
+        bodies.clear();
+        entities.clear();
+        poses.clear();
+        components.clear();
+        types.clear();
+        flags.clear();
+        synced.clear();
+        previous.clear();
+        activeSlots.clear();
+        active.clear();
+    }
+
+} // end of namespace
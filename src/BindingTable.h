@@ -0,0 +1,153 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+#pragma once
+
+// AST-Utilities includes
+#include <Suite2D/CBody.h>
+
+// C++ Standard Library includes
+#include <vector>
+#include <cstdint>
+
+// Forward declaration
+class b2Body;
+
+namespace astu::suite2d {
+
+    // Forward declaration
+    class CBox2DBody;
+    class CPose;
+
+    /**
+     * The pose of a body as exchanged between entities and Box2D.
+     */
+    struct BodyPose {
+        float x;
+        float y;
+        float angle;
+    };
+
+    /**
+     * Dense table binding entities to Box2D bodies.
+     *
+     * The table is organized as structure of arrays, each binding is
+     * identified by its index. Bindings get removed by swapping the last
+     * binding into the gap, hence indices of bindings might change.
+     */
+    class BindingTable {
+    public:
+
+        /** Flags stored per binding. */
+        enum Flags : uint8_t {
+            /** The last pose written to the entity was interpolated. */
+            Interpolated = 0x01,
+
+            /** The body is outside of all interest regions. */
+            Dormant = 0x02,
+
+            /** The body has been awake when it became dormant. */
+            WasAwake = 0x04,
+        };
+
+        /** The Box2D bodies. */
+        std::vector<b2Body*> bodies;
+
+        /** The entities. */
+        std::vector<Entity*> entities;
+
+        /** The poses of the entities. */
+        std::vector<CPose*> poses;
+
+        /** The body components of the entities. */
+        std::vector<CBox2DBody*> components;
+
+        /** The types of the bodies. */
+        std::vector<CBody::Type> types;
+
+        /** The flags of the bindings. */
+        std::vector<uint8_t> flags;
+
+        /** The poses last exchanged between entities and Box2D. */
+        std::vector<BodyPose> synced;
+
+        /** The poses of the Box2D bodies before the last step. */
+        std::vector<BodyPose> previous;
+
+        /** The indices within the active list, -1 for inactive bindings. */
+        std::vector<int> activeSlots;
+
+        /** The indices of bindings which might have moved during the last step. */
+        std::vector<int> active;
+
+        /**
+         * Returns the number of bindings.
+         *
+         * @return the number of bindings
+         */
+        size_t Size() const {
+            return bodies.size();
+        }
+
+        /**
+         * Reserves memory for the specified number of bindings.
+         *
+         * @param n the number of bindings
+         */
+        void Reserve(size_t n);
+
+        /**
+         * Returns the memory allocated by this table.
+         *
+         * @return the allocated memory in bytes
+         */
+        size_t GetMemoryUsage() const;
+
+        /**
+         * Adds a new binding.
+         *
+         * @param entity    the entity
+         * @param comp      the body component of the entity
+         * @param body      the Box2D body
+         * @param pose      the pose of the entity
+         * @return the index of the new binding
+         */
+        size_t Add(Entity& entity, CBox2DBody& comp, b2Body* body, CPose& pose);
+
+        /**
+         * Removes a binding.
+         *
+         * @param idx   the index of the binding to remove
+         */
+        void Remove(size_t idx);
+
+        /**
+         * Adds a binding to the active list, unless it is already active.
+         *
+         * @param idx   the index of the binding
+         */
+        void Activate(size_t idx) {
+            if (activeSlots[idx] < 0 && types[idx] != CBody::Type::Static) {
+                activeSlots[idx] = static_cast<int>(active.size());
+                active.push_back(static_cast<int>(idx));
+            }
+        }
+
+        /**
+         * Removes a binding from the active list.
+         *
+         * @param idx   the index of the binding
+         */
+        void Deactivate(size_t idx);
+
+        /**
+         * Removes all bindings.
+         */
+        void Clear();
+    };
+
+} // end of namespace
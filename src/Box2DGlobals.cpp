@@ -0,0 +1,37 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "Box2DGlobals.h"
+
+// Box2D includes
+#include <box2d/box2d.h>
+
+// C++ Standard Library includes
+#include <mutex>
+
+namespace astu::suite2d {
+
+    void PrepareConcurrentSteps()
+    {
+        static std::once_flag initialized;
+        std::call_once(initialized, [] {
+            // Two overlapping fixtures make the step create a contact,
+            // which builds the contact factories as a side effect.
+            b2World world(b2Vec2(0, 0));
+            b2CircleShape shape;
+            shape.m_radius = 1.0f;
+
+            b2BodyDef bodyDef;
+            world.CreateBody(&bodyDef)->CreateFixture(&shape, 0.0f);
+            bodyDef.type = b2_dynamicBody;
+            world.CreateBody(&bodyDef)->CreateFixture(&shape, 1.0f);
+            world.Step(0, 1, 1);
+        });
+    }
+
+} // end of namespace
@@ -0,0 +1,31 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+#pragma once
+
+namespace astu::suite2d {
+
+    /**
+     * Prepares the global state of Box2D for worlds stepped concurrently.
+     *
+     * Box2D builds the table of contact factories lazily when the first
+     * contact is created. This function builds it on the calling thread,
+     * hence worlds stepped concurrently afterwards do not race on it.
+     * Only the first call has an effect.
+     *
+     * Box2D also counts calls and iterations of its distance and
+     * time-of-impact functions in global variables, e.g., `b2_gjkCalls`,
+     * `b2_toiCalls`, `b2_toiIters` or `b2_toiMaxTime`. These counters are
+     * neither atomic nor compiled out in Box2D 2.4.1 and are updated by
+     * all worlds being stepped concurrently. Their values are meaningless
+     * in that case. They are diagnostics only and neither read by Box2D
+     * nor by this library, but thread sanitizers report the data race;
+     * suppress reports for `b2Distance` and `b2TimeOfImpact`.
+     */
+    void PrepareConcurrentSteps();
+
+} // end of namespace
@@ -0,0 +1,174 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "Box2DPhysicsSystem.h"
+#include "CBox2DBody.h"
+#include "AsyncStepper.h"
+#include "Box2DGlobals.h"
+#include "CBox2DColliders.h"
+#include "BindingTable.h"
+#include "CommandQueue.h"
+#include "StepRecorder.h"
+
+// C++ Standard Library includes
+#include <stdexcept>
+#include <algorithm>
+
+using namespace std;
+
+namespace astu::suite2d {
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetAsyncStep(bool b)
+    {
+        if (b == asyncStep) {
+            return *this;
+        }
+
+        if (b && group) {
+            throw std::logic_error("Physics systems of world groups cannot step asynchronously");
+        }
+
+        if (!b) {
+            FinishAsyncStep();
+            stepper = nullptr;
+        } else if (world) {
+            PrepareConcurrentSteps();
+            stepper = make_unique<AsyncStepper>([this] { Simulate(); });
+        }
+        asyncStep = b;
+        return *this;
+    }
+
+    void Box2DPhysicsSystem::UpdateAsync()
+    {
+        FinishAsyncStep();
+        BeginUpdate();
+        stepPending = true;
+        stepper->Kick();
+    }
+
+    void Box2DPhysicsSystem::FinishAsyncStep()
+    {
+        if (!stepPending) {
+            return;
+        }
+
+        WaitForStep();
+        stepPending = false;
+
+        // Poses changed while the step was running are pushed before the
+        // results are deployed, otherwise they would be overwritten.
+        ApplyCommands();
+        CollectTransforms();
+        EndUpdate();
+
+        // The buffers just filled are published, the others get refilled.
+        publishedEvents.swap(contactEvents);
+        publishedImpacts.swap(impacts);
+        publishedSensorEvents.swap(sensorEvents);
+        reportedSensorEvents = sensorEvents.size();
+        publishedStats = stepStats;
+    }
+
+    void Box2DPhysicsSystem::WaitForStep() const
+    {
+        if (stepper) {
+            stepper->Wait();
+        }
+    }
+
+    bool Box2DPhysicsSystem::IsStepping() const
+    {
+        return stepper && stepper->IsBusy();
+    }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetDeferredCommands(bool b)
+    {
+        if (!b && deferredCommands && world) {
+            WaitForStep();
+            ApplyCommands();
+        }
+        deferredCommands = b;
+        return *this;
+    }
+
+    bool Box2DPhysicsSystem::IsDeferringCommands() const
+    {
+        return deferredCommands || IsStepping();
+    }
+
+    CommandBuffer& Box2DPhysicsSystem::GetCommandBuffer()
+    {
+        return commandQueue->GetBuffer();
+    }
+
+    void Box2DPhysicsSystem::ApplyCommands()
+    {
+        // The step has finished, hence the changes take effect immediately.
+        size_t numBodySources = 0;
+        size_t numColliderSources = 0;
+        commandQueue->ForEachBuffer([&](CommandBuffer& buffer) {
+            for (auto col : buffer.colliders) {
+                if (!col) {
+                    continue;
+                }
+                ColliderCommand cmd{-1, 0, col};
+                if (auto fx = col->GetLastFixture()) {
+                    auto body = reinterpret_cast<CBox2DBody*>(fx->GetBody()->GetUserData().pointer);
+                    cmd.bindingIndex = body->bindingIndex;
+                    cmd.fixtureIndex = GetFixtureIndex(*fx);
+                }
+                commandColliders.push_back(cmd);
+            }
+            for (auto body : buffer.bodies) {
+                if (body) {
+                    commandBodies.push_back(body);
+                }
+            }
+            if (!buffer.colliders.empty()) {
+                ++numColliderSources;
+            }
+            if (!buffer.bodies.empty()) {
+                ++numBodySources;
+            }
+            buffer.colliders.clear();
+            buffer.bodies.clear();
+        });
+
+        // Threads are scheduled arbitrarily, sorting the changes of several
+        // threads keeps the simulation reproducible. Changes of filters and
+        // sensors refilter contacts, hence colliders are ordered as well.
+        if (numColliderSources > 1) {
+            sort(commandColliders.begin(), commandColliders.end(),
+                [](const ColliderCommand& a, const ColliderCommand& b) {
+                    if (a.bindingIndex != b.bindingIndex) {
+                        return a.bindingIndex < b.bindingIndex;
+                    }
+                    return a.fixtureIndex < b.fixtureIndex;
+                });
+        }
+
+        for (const auto& cmd : commandColliders) {
+            cmd.collider->ApplyPendingChanges();
+        }
+        commandColliders.clear();
+
+        if (numBodySources > 1) {
+            sort(commandBodies.begin(), commandBodies.end(),
+                [](const CBox2DBody* a, const CBox2DBody* b) {
+                    return a->bindingIndex < b->bindingIndex;
+                });
+        }
+
+        for (auto body : commandBodies) {
+            body->ApplyPendingChanges();
+        }
+        commandBodies.clear();
+    }
+
+} // end of namespace
@@ -0,0 +1,292 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "Box2DPhysicsSystem.h"
+#include "BindingTable.h"
+#include "StepRecorder.h"
+#include "ShapeCache.h"
+#include "CommandQueue.h"
+#include "SensorContact.h"
+#include "WorldReservation.h"
+
+// Box2D includes
+#include <box2d/box2d.h>
+
+// C++ Standard Library includes
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+
+namespace astu::suite2d {
+
+    /** The distance between placeholder bodies used to reserve capacity. */
+    static const float PLACEHOLDER_SPACING = 4.0f;
+
+    /** The number of placeholder bodies per row. */
+    static const size_t PLACEHOLDER_COLUMNS = 256;
+
+    /** The block sizes of the Box2D block allocator, see b2_block_allocator.cpp. */
+    static const size_t BLOCK_SIZES[] = {16, 32, 64, 96, 128, 160, 192, 224, 256, 320, 384, 448, 512, 640};
+
+    /** The initial number of nodes of the Box2D broad-phase tree. */
+    static const size_t INITIAL_TREE_CAPACITY = 16;
+
+    /**
+     * Returns the memory taken by an object of the Box2D block allocator.
+     *
+     * @param size  the size of the object in bytes
+     * @return the size of the block holding the object
+     */
+    static size_t BlockSize(size_t size)
+    {
+        for (auto blockSize : BLOCK_SIZES) {
+            if (size <= blockSize) {
+                return blockSize;
+            }
+        }
+
+        // Larger objects are allocated by b2Alloc.
+        return size;
+    }
+
+    /**
+     * Returns the memory of a fixture, including its broad-phase proxies.
+     *
+     * @param numChildren   the number of child shapes of the fixture
+     * @return the memory in bytes
+     */
+    static size_t FixtureSize(int numChildren)
+    {
+        return BlockSize(sizeof(b2Fixture)) + BlockSize(numChildren * sizeof(b2FixtureProxy));
+    }
+
+    /**
+     * Estimates the number of nodes allocated by the broad-phase tree.
+     *
+     * The tree doubles its capacity when it runs out of nodes and never
+     * shrinks.
+     *
+     * @param peakNodes the peak number of nodes in use
+     * @return the estimated capacity of the tree
+     */
+    static size_t TreeCapacity(size_t peakNodes)
+    {
+        size_t result = INITIAL_TREE_CAPACITY;
+        while (result < peakNodes) {
+            result *= 2;
+        }
+        return result;
+    }
+
+    /**
+     * Returns the memory allocated by a vector.
+     */
+    template <typename T>
+    static inline size_t CapacityBytes(const vector<T>& v)
+    {
+        return v.capacity() * sizeof(T);
+    }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::ReserveCapacity(const WorldCapacity& c)
+    {
+        capacity = c;
+        ReserveBodies(c.bodies);
+        if (!world) {
+            return *this;
+        }
+
+        WaitForStep();
+        if (world->GetBodyCount() == 0) {
+            // Empty worlds are replaced in order to reserve contacts.
+            CreateWorld();
+        } else {
+            ReserveWorldCapacity();
+            if (recorder) {
+                recorder->WriteReserve(capacity);
+            }
+        }
+        return *this;
+    }
+
+    void Box2DPhysicsSystem::ClearWorld()
+    {
+        if (!world) {
+            return;
+        }
+
+        // The results of a running step are discarded.
+        WaitForStep();
+        stepPending = false;
+
+        // The replay replaces its world as well, see CreateWorld.
+        UnbindAll();
+        CreateWorld();
+    }
+
+    ReservedMemory ReserveWorldMemory(b2World& world, const WorldCapacity& capacity)
+    {
+        const size_t numContacts = world.GetBodyCount() == 0 ? capacity.contacts : 0;
+        size_t numBodies = capacity.bodies;
+        if (numBodies == 0 && (capacity.fixtures > 0 || numContacts > 0)) {
+            numBodies = 1;
+        }
+        if (numBodies == 0) {
+            return ReservedMemory();
+        }
+
+        // Each fixture of a dynamic placeholder touches the corresponding
+        // fixture of its static partner at the same position.
+        const size_t fixturesPerBody = (max(capacity.fixtures, numBodies) + numBodies - 1) / numBodies;
+        const size_t numPairs = (numContacts + fixturesPerBody - 1) / fixturesPerBody;
+        numBodies = max(numBodies, numPairs * 2);
+
+        vector<b2Body*> placeholders;
+        placeholders.reserve(numBodies);
+
+        b2BodyDef bodyDef;
+        b2PolygonShape shape;
+        b2FixtureDef fixtureDef;
+        fixtureDef.shape = &shape;
+        fixtureDef.density = 1.0f;
+        for (size_t i = 0; i < numBodies; ++i) {
+            const size_t slot = i < numPairs * 2 ? i / 2 : i - numPairs;
+            bodyDef.type = i < numPairs * 2 && i % 2 == 0 ? b2_dynamicBody : b2_staticBody;
+            bodyDef.position.Set(
+                (slot % PLACEHOLDER_COLUMNS) * fixturesPerBody * PLACEHOLDER_SPACING,
+                (slot / PLACEHOLDER_COLUMNS) * PLACEHOLDER_SPACING);
+            b2Body* body = world.CreateBody(&bodyDef);
+            for (size_t j = 0; j < fixturesPerBody; ++j) {
+                shape.SetAsBox(0.5f, 0.5f, b2Vec2(j * PLACEHOLDER_SPACING, 0), 0);
+                body->CreateFixture(&fixtureDef);
+            }
+            placeholders.push_back(body);
+        }
+
+        if (numPairs > 0) {
+            // A step of zero length creates contacts without moving bodies,
+            // the solver and thereby the iterations are not used.
+            world.Step(0, 1, 1);
+        }
+
+        for (auto body : placeholders) {
+            world.DestroyBody(body);
+        }
+
+        // The destroyed placeholders are kept by the block allocator.
+        const size_t numFixtures = numBodies * fixturesPerBody;
+        const size_t blockBytes = numBodies * BlockSize(sizeof(b2Body))
+            + numFixtures * (FixtureSize(1) + BlockSize(sizeof(b2PolygonShape)))
+            + numPairs * fixturesPerBody * BlockSize(sizeof(b2Contact));
+        ReservedMemory result;
+        result.blockBytes = blockBytes;
+        result.treeNodes = (static_cast<size_t>(world.GetProxyCount()) + numFixtures) * 2;
+        return result;
+    }
+
+    void Box2DPhysicsSystem::ReserveWorldCapacity()
+    {
+        const auto reserved = ReserveWorldMemory(*world, capacity);
+        worldBlockPeak = max(worldBlockPeak, reserved.blockBytes);
+        worldNodePeak = max(worldNodePeak, reserved.treeNodes);
+    }
+
+    MemoryReport Box2DPhysicsSystem::GetMemoryReport()
+    {
+        MemoryReport report;
+        if (world) {
+            WaitForStep();
+            report.world = {1, sizeof(b2World)};
+
+            size_t blockBytes = 0;
+            for (const b2Body* body = world->GetBodyList(); body; body = body->GetNext()) {
+                for (const b2Fixture* fx = body->GetFixtureList(); fx; fx = fx->GetNext()) {
+                    const b2Shape* shape = fx->GetShape();
+                    const size_t fixtureBytes = FixtureSize(shape->GetChildCount());
+                    report.fixtures.count++;
+                    report.fixtures.bytes += fixtureBytes;
+                    blockBytes += fixtureBytes;
+
+                    size_t shapeSize = 0;
+                    switch (shape->GetType()) {
+                    case b2Shape::e_circle:
+                        shapeSize = sizeof(b2CircleShape);
+                        break;
+                    case b2Shape::e_edge:
+                        shapeSize = sizeof(b2EdgeShape);
+                        break;
+                    case b2Shape::e_polygon:
+                        shapeSize = sizeof(b2PolygonShape);
+                        break;
+                    case b2Shape::e_chain:
+                        shapeSize = sizeof(b2ChainShape);
+                        // Chain vertices are allocated by b2Alloc.
+                        report.shapes.bytes += static_cast<const b2ChainShape*>(shape)->m_count * sizeof(b2Vec2);
+                        break;
+                    default:
+                        break;
+                    }
+                    report.shapes.count++;
+                    report.shapes.bytes += BlockSize(shapeSize);
+                    blockBytes += BlockSize(shapeSize);
+                }
+            }
+
+            report.bodies.count = world->GetBodyCount();
+            report.bodies.bytes = report.bodies.count * BlockSize(sizeof(b2Body));
+            report.contacts.count = world->GetContactCount();
+            report.contacts.bytes = report.contacts.count * BlockSize(sizeof(b2Contact));
+            blockBytes += report.bodies.bytes + report.contacts.bytes;
+            worldBlockPeak = max(worldBlockPeak, blockBytes);
+            report.allocatorSlack.bytes = worldBlockPeak - blockBytes;
+
+            const size_t numProxies = world->GetProxyCount();
+            report.treeNodes.count = numProxies > 0 ? numProxies * 2 - 1 : 0;
+            worldNodePeak = max(worldNodePeak, report.treeNodes.count);
+            report.treeNodes.bytes = TreeCapacity(worldNodePeak) * sizeof(b2TreeNode);
+        }
+
+        report.bindings.count = bindings->Size() + pendingSpawns.size() + pendingDespawns.size();
+        report.bindings.bytes = bindings->GetMemoryUsage()
+            + CapacityBytes(pendingSpawns) + CapacityBytes(pendingDespawns);
+
+        report.shapeCache.count = shapeCache->Size();
+        report.shapeCache.bytes = shapeCache->GetMemoryUsage();
+
+        report.buffers.count = contactEvents.size() + impacts.size() + sensorEvents.size()
+            + publishedEvents.size() + publishedImpacts.size() + publishedSensorEvents.size()
+            + sensorContacts.size() + commandQueue->Size();
+        report.buffers.bytes = CapacityBytes(contactEvents) + CapacityBytes(impacts)
+            + CapacityBytes(sensorEvents) + CapacityBytes(publishedEvents)
+            + CapacityBytes(publishedImpacts) + CapacityBytes(publishedSensorEvents)
+            + CapacityBytes(sensorContacts) + CapacityBytes(commandBodies)
+            + CapacityBytes(commandColliders)
+            + contactImpacts.size() * (sizeof(pair<const b2Contact*, ContactImpact>) + sizeof(void*))
+            + commandQueue->GetMemoryUsage();
+
+        report.totalBytes = report.world.bytes + report.bodies.bytes + report.fixtures.bytes
+            + report.shapes.bytes + report.contacts.bytes + report.treeNodes.bytes
+            + report.allocatorSlack.bytes + report.bindings.bytes + report.shapeCache.bytes
+            + report.buffers.bytes;
+        memoryPeak = max(memoryPeak, report.totalBytes);
+        report.peakBytes = memoryPeak;
+
+        return report;
+    }
+
+    void Box2DPhysicsSystem::InvalidatePolygon(const Polygon& polygon)
+    {
+        shapeCache->Invalidate(polygon);
+    }
+
+    void Box2DPhysicsSystem::PurgeShapeCache()
+    {
+        shapeCache->Purge();
+    }
+
+} // end of namespace
@@ -0,0 +1,593 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "Box2DPhysicsSystem.h"
+#include "CBox2DColliders.h"
+#include "WorkerPool.h"
+
+// Box2D includes
+#include <box2d/box2d.h>
+
+// C++ Standard Library includes
+#include <stdexcept>
+
+using namespace std;
+
+namespace astu::suite2d {
+
+    /** The number of rays processed as one chunk by batched ray casts. */
+    static const size_t RAY_CAST_GRAIN = 64;
+
+    /**
+     * Tests whether a fixture passes the filter of a query.
+     *
+     * @param fixture       the fixture to test
+     * @param categoryBits  the category bits of the query
+     * @param maskBits      the mask bits of the query
+     * @return `true` if the fixture passes the filter
+     */
+    static inline bool PassesFilter(const b2Fixture& fixture, uint16_t categoryBits, uint16_t maskBits)
+    {
+        const b2Filter& filter = fixture.GetFilterData();
+        return (filter.categoryBits & maskBits) != 0 && (filter.maskBits & categoryBits) != 0;
+    }
+
+    /**
+     * Tests whether a fixture passes a query filter.
+     *
+     * @param fixture   the fixture to test
+     * @param filter    the query filter
+     * @return `true` if the fixture passes the filter
+     */
+    static inline bool PassesFilter(const b2Fixture& fixture, const QueryFilter& filter)
+    {
+        return (filter.includeSensors || !fixture.IsSensor()) 
+            && PassesFilter(fixture, filter.categoryBits, filter.maskBits);
+    }
+
+    /**
+     * Returns the collider component added to the entity owning a fixture.
+     *
+     * @param fixture   the fixture
+     * @return the collider component
+     */
+    static inline CBodyCollider& GetCollider(b2Fixture& fixture)
+    {
+        return reinterpret_cast<IBox2DCollider*>(fixture.GetUserData().pointer)->GetRootCollider();
+    }
+
+    /**
+     * Returns the collider a fixture has been created for.
+     *
+     * @param fixture   the fixture
+     * @return the sub-collider in case of compound colliders, the collider component otherwise
+     */
+    static inline CBodyCollider& GetSubCollider(b2Fixture& fixture)
+    {
+        return reinterpret_cast<IBox2DCollider*>(fixture.GetUserData().pointer)->GetBodyCollider();
+    }
+
+    /**
+     * Forwards fixtures reported by the broad-phase to a function.
+     */
+    template <typename F>
+    class QueryCallbackAdapter : public b2QueryCallback {
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param func  the function receiving the fixtures
+         */
+        QueryCallbackAdapter(F& func) : func(func) {}
+
+        // Inherited via b2QueryCallback
+        virtual bool ReportFixture(b2Fixture* fixture) override {
+            return func(fixture);
+        }
+
+    private:
+        /** The function receiving the fixtures. */
+        F& func;
+    };
+
+    /**
+     * Runs a broad-phase query and forwards the fixtures to a function.
+     *
+     * @param world the world to query
+     * @param aabb  the axis-aligned box to query
+     * @param func  the function receiving the fixtures
+     */
+    template <typename F>
+    static void QueryFixtures(const b2World& world, const b2AABB& aabb, F func)
+    {
+        QueryCallbackAdapter<F> callback(func);
+        world.QueryAABB(&callback, aabb);
+    }
+
+    /**
+     * Remembers fixtures with multiple children already reported.
+     *
+     * The broad-phase reports such fixtures once per child proxy. Without
+     * heap allocation only a limited number of them can be remembered,
+     * beyond that duplicates might be reported.
+     */
+    class MultiChildFilter {
+    public:
+
+        MultiChildFilter() : count(0) {}
+
+        /**
+         * Tests whether a fixture is reported for the first time.
+         *
+         * @param fixture   the fixture
+         * @return `true` if the fixture has not been reported before
+         */
+        bool IsFirst(const b2Fixture* fixture) {
+            for (size_t i = 0; i < count; ++i) {
+                if (fixtures[i] == fixture) {
+                    return false;
+                }
+            }
+            if (count < MAX_FIXTURES) {
+                fixtures[count++] = fixture;
+            }
+            return true;
+        }
+
+    private:
+        /** The maximum number of fixtures remembered. */
+        static const size_t MAX_FIXTURES = 32;
+
+        /** The fixtures already reported. */
+        const b2Fixture* fixtures[MAX_FIXTURES];
+
+        /** The number of fixtures already reported. */
+        size_t count;
+    };
+
+    /**
+     * Writes overlap query results to a buffer.
+     */
+    class BufferOverlapListener : public OverlapListener {
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param hits      the buffer receiving the results
+         * @param capacity  the capacity of the buffer
+         */
+        BufferOverlapListener(OverlapHit* hits, size_t capacity)
+            : hits(hits), capacity(capacity), count(0)
+        {
+            // Intentionally left empty.
+        }
+
+        // Inherited via OverlapListener
+        virtual bool OnOverlap(const OverlapHit& hit) override {
+            if (count < capacity) {
+                hits[count++] = hit;
+            }
+            return count < capacity;
+        }
+
+        /** The buffer receiving the results. */
+        OverlapHit* hits;
+
+        /** The capacity of the buffer. */
+        size_t capacity;
+
+        /** The number of results written to the buffer. */
+        size_t count;
+    };
+
+    /**
+     * Creates a Box2D polygon shape.
+     *
+     * @param vertices  the vertices of the polygon
+     * @param count     the number of vertices
+     * @param shape     receives the polygon
+     */
+    static void MakePolygon(const Vector2f* vertices, size_t count, b2PolygonShape& shape)
+    {
+        if (count < 3 || count > b2_maxPolygonVertices) {
+            throw std::logic_error("Query polygons must have between 3 and 8 vertices");
+        }
+
+        b2Vec2 points[b2_maxPolygonVertices];
+        for (size_t i = 0; i < count; ++i) {
+            points[i].Set(vertices[i].x, vertices[i].y);
+        }
+
+        if (!shape.Set(points, static_cast<int32>(count))) {
+            throw std::logic_error("Query polygon is degenerated");
+        }
+    }
+
+    /**
+     * Used to determine the closest hit of a ray.
+     */
+    class ClosestRayCastCallback : public b2RayCastCallback {
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param query the ray which is cast
+         */
+        ClosestRayCastCallback(const RayCastQuery& query)
+            : query(query)
+            , fixture(nullptr)
+            , fraction(1.0f)
+        {
+            // Intentionally left empty.
+        }
+
+        // Inherited via b2RayCastCallback
+        virtual float ReportFixture(b2Fixture* fix, const b2Vec2& p, const b2Vec2& n, float f) override {
+            if (fix->IsSensor() || !PassesFilter(*fix, query.categoryBits, query.maskBits)) {
+                // Ignore this fixture and continue.
+                return -1;
+            }
+
+            fixture = fix;
+            point = p;
+            normal = n;
+            fraction = f;
+
+            // Clip the ray to find closer hits.
+            return f;
+        }
+
+        /** The ray which is cast. */
+        const RayCastQuery& query;
+
+        /** The closest fixture hit, `nullptr` if nothing has been hit. */
+        b2Fixture* fixture;
+
+        /** The point of the closest hit. */
+        b2Vec2 point;
+
+        /** The normal of the closest hit. */
+        b2Vec2 normal;
+
+        /** The fraction of the closest hit. */
+        float fraction;
+    };
+
+    bool Box2DPhysicsSystem::RayCast(const RayCastQuery& query, RayCastHit& hit) const
+    {
+        WaitForStep();
+        return CastRay(query, hit);
+    }
+
+    bool Box2DPhysicsSystem::CastRay(const RayCastQuery& query, RayCastHit& hit) const
+    {
+        ClosestRayCastCallback callback(query);
+        world->RayCast(&callback,
+            b2Vec2(query.from.x, query.from.y),
+            b2Vec2(query.to.x, query.to.y));
+
+        if (!callback.fixture) {
+            hit.entity = nullptr;
+            hit.collider = nullptr;
+            hit.subCollider = nullptr;
+            hit.fraction = 1.0f;
+            return false;
+        }
+
+        hit.entity = GetEntity(*callback.fixture);
+        hit.collider = &GetCollider(*callback.fixture);
+        hit.subCollider = &GetSubCollider(*callback.fixture);
+        hit.point.Set(callback.point.x, callback.point.y);
+        hit.normal.Set(callback.normal.x, callback.normal.y);
+        hit.fraction = callback.fraction;
+        return true;
+    }
+
+    void Box2DPhysicsSystem::RayCast(const RayCastQuery* queries, RayCastHit* hits, size_t count)
+    {
+        WaitForStep();
+
+        // Ray casts do not modify the world, hence they can be processed
+        // concurrently as long as the world is not stepped. Workers must
+        // not wait for the step themselves, exceptions of the step would
+        // escape the worker threads.
+        auto castRange = [this, queries, hits](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                CastRay(queries[i], hits[i]);
+            }
+        };
+
+        if (workerPool) {
+            workerPool->ParallelFor(count, RAY_CAST_GRAIN, castRange);
+        } else {
+            castRange(0, count);
+        }
+    }
+
+    size_t Box2DPhysicsSystem::QueryAABB(const Vector2f& lower, const Vector2f& upper, const QueryFilter& filter, OverlapHit* hits, size_t capacity) const
+    {
+        BufferOverlapListener listener(hits, capacity);
+        if (capacity > 0) {
+            QueryAABB(lower, upper, filter, listener);
+        }
+        return listener.count;
+    }
+
+    void Box2DPhysicsSystem::QueryAABB(const Vector2f& lower, const Vector2f& upper, const QueryFilter& filter, OverlapListener& listener) const
+    {
+        WaitForStep();
+
+        b2AABB aabb;
+        aabb.lowerBound.Set(lower.x, lower.y);
+        aabb.upperBound.Set(upper.x, upper.y);
+
+        MultiChildFilter multiChildFilter;
+        QueryFixtures(*world, aabb, [&](b2Fixture* fixture) {
+            if (!PassesFilter(*fixture, filter)) {
+                return true;
+            }
+
+            // The broad-phase uses enlarged bounding boxes.
+            int32 numChildren = fixture->GetShape()->GetChildCount();
+            for (int32 i = 0; i < numChildren; ++i) {
+                if (b2TestOverlap(fixture->GetAABB(i), aabb)) {
+                    if (numChildren > 1 && !multiChildFilter.IsFirst(fixture)) {
+                        return true;
+                    }
+                    return listener.OnOverlap({GetEntity(*fixture), &GetCollider(*fixture), &GetSubCollider(*fixture)});
+                }
+            }
+            return true;
+        });
+    }
+
+    size_t Box2DPhysicsSystem::OverlapCircle(const Vector2f& center, float radius, const QueryFilter& filter, OverlapHit* hits, size_t capacity) const
+    {
+        BufferOverlapListener listener(hits, capacity);
+        if (capacity > 0) {
+            OverlapCircle(center, radius, filter, listener);
+        }
+        return listener.count;
+    }
+
+    void Box2DPhysicsSystem::OverlapCircle(const Vector2f& center, float radius, const QueryFilter& filter, OverlapListener& listener) const
+    {
+        b2CircleShape shape;
+        shape.m_radius = radius;
+
+        b2Transform xf;
+        xf.Set(b2Vec2(center.x, center.y), 0);
+        QueryOverlap(shape, xf, filter, listener);
+    }
+
+    size_t Box2DPhysicsSystem::OverlapBox(const Vector2f& center, const Vector2f& halfExtents, float angle, const QueryFilter& filter, OverlapHit* hits, size_t capacity) const
+    {
+        b2PolygonShape shape;
+        shape.SetAsBox(halfExtents.x, halfExtents.y);
+
+        b2Transform xf;
+        xf.Set(b2Vec2(center.x, center.y), angle);
+
+        BufferOverlapListener listener(hits, capacity);
+        if (capacity > 0) {
+            QueryOverlap(shape, xf, filter, listener);
+        }
+        return listener.count;
+    }
+
+    size_t Box2DPhysicsSystem::OverlapPolygon(const Vector2f* vertices, size_t count, const Vector2f& position, float angle, const QueryFilter& filter, OverlapHit* hits, size_t capacity) const
+    {
+        BufferOverlapListener listener(hits, capacity);
+        if (capacity > 0) {
+            OverlapPolygon(vertices, count, position, angle, filter, listener);
+        }
+        return listener.count;
+    }
+
+    void Box2DPhysicsSystem::OverlapPolygon(const Vector2f* vertices, size_t count, const Vector2f& position, float angle, const QueryFilter& filter, OverlapListener& listener) const
+    {
+        b2PolygonShape shape;
+        MakePolygon(vertices, count, shape);
+
+        b2Transform xf;
+        xf.Set(b2Vec2(position.x, position.y), angle);
+        QueryOverlap(shape, xf, filter, listener);
+    }
+
+    bool Box2DPhysicsSystem::SweepCircle(const Vector2f& center, float radius, const Vector2f& translation, const QueryFilter& filter, SweepHit& hit) const
+    {
+        b2CircleShape shape;
+        shape.m_radius = radius;
+
+        b2Transform xf;
+        xf.Set(b2Vec2(center.x, center.y), 0);
+        return QuerySweep(shape, xf, translation, 0, filter, hit);
+    }
+
+    bool Box2DPhysicsSystem::SweepPolygon(const Vector2f* vertices, size_t count, const Vector2f& position, float angle, const Vector2f& translation, float rotation, const QueryFilter& filter, SweepHit& hit) const
+    {
+        b2PolygonShape shape;
+        MakePolygon(vertices, count, shape);
+
+        b2Transform xf;
+        xf.Set(b2Vec2(position.x, position.y), angle);
+        return QuerySweep(shape, xf, translation, rotation, filter, hit);
+    }
+
+    void Box2DPhysicsSystem::QueryOverlap(const b2Shape& shape, const b2Transform& xf, const QueryFilter& filter, OverlapListener& listener) const
+    {
+        WaitForStep();
+
+        const int32 numShapeChildren = shape.GetChildCount();
+        b2AABB aabb;
+        shape.ComputeAABB(&aabb, xf, 0);
+        for (int32 j = 1; j < numShapeChildren; ++j) {
+            b2AABB childAabb;
+            shape.ComputeAABB(&childAabb, xf, j);
+            aabb.Combine(childAabb);
+        }
+
+        MultiChildFilter multiChildFilter;
+        QueryFixtures(*world, aabb, [&](b2Fixture* fixture) {
+            if (!PassesFilter(*fixture, filter)) {
+                return true;
+            }
+
+            const b2Shape* other = fixture->GetShape();
+            const b2Transform& otherXf = fixture->GetBody()->GetTransform();
+            const int32 numChildren = other->GetChildCount();
+            if (numChildren > 1 && !multiChildFilter.IsFirst(fixture)) {
+                return true;
+            }
+
+            for (int32 i = 0; i < numChildren; ++i) {
+                if (numChildren > 1 && !b2TestOverlap(fixture->GetAABB(i), aabb)) {
+                    continue;
+                }
+                for (int32 j = 0; j < numShapeChildren; ++j) {
+                    if (b2TestOverlap(other, i, &shape, j, otherXf, xf)) {
+                        return listener.OnOverlap({GetEntity(*fixture), &GetCollider(*fixture), &GetSubCollider(*fixture)});
+                    }
+                }
+            }
+            return true;
+        });
+    }
+
+    bool Box2DPhysicsSystem::QuerySweep(const b2Shape& shape, const b2Transform& xf, const Vector2f& translation, float rotation, const QueryFilter& filter, SweepHit& hit) const
+    {
+        WaitForStep();
+
+        // Conservative bounds of the swept shape, taking rotation into account.
+        b2Transform identity;
+        identity.SetIdentity();
+        b2AABB local;
+        shape.ComputeAABB(&local, identity, 0);
+        float radius = b2Max(
+            b2Max(local.lowerBound.Length(), local.upperBound.Length()),
+            b2Max(b2Vec2(local.lowerBound.x, local.upperBound.y).Length(), 
+                b2Vec2(local.upperBound.x, local.lowerBound.y).Length()));
+
+        const b2Vec2 start = xf.p;
+        const b2Vec2 end = start + b2Vec2(translation.x, translation.y);
+        const b2Vec2 extent(radius, radius);
+
+        b2AABB aabb;
+        aabb.lowerBound = b2Min(start, end) - extent;
+        aabb.upperBound = b2Max(start, end) + extent;
+
+        const float angle = xf.q.GetAngle();
+        b2Sweep sweepB;
+        sweepB.localCenter.SetZero();
+        sweepB.c0 = start;
+        sweepB.c = end;
+        sweepB.a0 = angle;
+        sweepB.a = angle + rotation;
+        sweepB.alpha0 = 0;
+
+        b2TOIInput input;
+        input.proxyB.Set(&shape, 0);
+        input.sweepB = sweepB;
+
+        b2Fixture* bestFixture = nullptr;
+        int32 bestChild = 0;
+        float bestFraction = 1.0f;
+
+        QueryFixtures(*world, aabb, [&](b2Fixture* fixture) {
+            if (!PassesFilter(*fixture, filter)) {
+                return true;
+            }
+
+            const b2Shape* other = fixture->GetShape();
+            const b2Transform& otherXf = fixture->GetBody()->GetTransform();
+            const int32 numChildren = other->GetChildCount();
+
+            // Bodies are considered to be at rest during the sweep.
+            input.sweepA.localCenter.SetZero();
+            input.sweepA.c0 = otherXf.p;
+            input.sweepA.c = otherXf.p;
+            input.sweepA.a0 = otherXf.q.GetAngle();
+            input.sweepA.a = input.sweepA.a0;
+            input.sweepA.alpha0 = 0;
+
+            for (int32 i = 0; i < numChildren; ++i) {
+                input.proxyA.Set(other, i);
+                input.tMax = bestFraction;
+
+                b2TOIOutput output;
+                b2TimeOfImpact(&output, &input);
+
+                float t;
+                switch (output.state) {
+                case b2TOIOutput::e_overlapped:
+                    t = 0;
+                    break;
+
+                case b2TOIOutput::e_touching:
+                case b2TOIOutput::e_failed:
+                    t = output.t;
+                    break;
+
+                default:
+                    continue;
+                }
+
+                if (t < bestFraction || !bestFixture) {
+                    bestFixture = fixture;
+                    bestChild = i;
+                    bestFraction = t;
+                }
+            }
+
+            return true;
+        });
+
+        if (!bestFixture) {
+            hit.entity = nullptr;
+            hit.collider = nullptr;
+            hit.subCollider = nullptr;
+            hit.fraction = 1.0f;
+            return false;
+        }
+
+        // Compute point and normal of the impact using the closest points.
+        b2DistanceInput distInput;
+        distInput.proxyA.Set(bestFixture->GetShape(), bestChild);
+        distInput.proxyB.Set(&shape, 0);
+        distInput.transformA = bestFixture->GetBody()->GetTransform();
+        sweepB.GetTransform(&distInput.transformB, bestFraction);
+        distInput.useRadii = false;
+
+        b2SimplexCache cache;
+        cache.count = 0;
+        b2DistanceOutput distOutput;
+        b2Distance(&distOutput, &cache, &distInput);
+
+        b2Vec2 normal = distOutput.pointB - distOutput.pointA;
+        if (normal.Normalize() < b2_epsilon) {
+            // Shapes overlap, use the direction opposing the sweep.
+            normal = -b2Vec2(translation.x, translation.y);
+            if (normal.Normalize() < b2_epsilon) {
+                normal.Set(0, 0);
+            }
+        }
+        b2Vec2 point = distOutput.pointA + distInput.proxyA.m_radius * normal;
+
+        hit.entity = GetEntity(*bestFixture);
+        hit.collider = &GetCollider(*bestFixture);
+        hit.subCollider = &GetSubCollider(*bestFixture);
+        hit.point.Set(point.x, point.y);
+        hit.normal.Set(normal.x, normal.y);
+        hit.fraction = bestFraction;
+        return true;
+    }
+
+} // end of namespace
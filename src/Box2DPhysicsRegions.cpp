@@ -0,0 +1,266 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "Box2DPhysicsSystem.h"
+#include "CBox2DBody.h"
+#include "BindingTable.h"
+#include "StepRecorder.h"
+
+// Box2D includes
+#include <box2d/box2d.h>
+
+// C++ Standard Library includes
+#include <stdexcept>
+
+using namespace std;
+
+namespace astu::suite2d {
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetSleepingAllowed(bool b)
+    {
+        sleepingAllowed = b;
+        if (world) {
+            WaitForStep();
+            world->SetAllowSleeping(b);
+            if (recorder) {
+                recorder->WriteAllowSleeping(b);
+            }
+        }
+        return *this;
+    }
+
+    size_t Box2DPhysicsSystem::AddInterestRegion(const InterestRegion& region)
+    {
+        regions.push_back(region);
+        regionsChanged = true;
+        return regions.size() - 1;
+    }
+
+    void Box2DPhysicsSystem::SetInterestRegion(size_t idx, const InterestRegion& region)
+    {
+        if (idx >= regions.size()) {
+            throw std::logic_error("Invalid index of interest region");
+        }
+        regions[idx] = region;
+        regionsChanged = true;
+    }
+
+    const InterestRegion& Box2DPhysicsSystem::GetInterestRegion(size_t idx) const
+    {
+        if (idx >= regions.size()) {
+            throw std::logic_error("Invalid index of interest region");
+        }
+        return regions[idx];
+    }
+
+    void Box2DPhysicsSystem::RemoveInterestRegion(size_t idx)
+    {
+        if (idx >= regions.size()) {
+            throw std::logic_error("Invalid index of interest region");
+        }
+        regions.erase(regions.begin() + idx);
+        regionsChanged = true;
+    }
+
+    void Box2DPhysicsSystem::ClearInterestRegions()
+    {
+        regions.clear();
+        regionsChanged = true;
+    }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetRegionMode(RegionMode mode)
+    {
+        if (mode != regionMode) {
+            WaitForStep();
+            ReactivateAll();
+            regionMode = mode;
+            regionsChanged = true;
+        }
+        return *this;
+    }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetRegionMargin(float margin)
+    {
+        if (margin < 0) {
+            throw std::logic_error("Region margin must not be negative");
+        }
+        regionMargin = margin;
+        regionsChanged = true;
+        return *this;
+    }
+
+    bool Box2DPhysicsSystem::IsDormant(const CBox2DBody& body) const
+    {
+        return body.bindingIndex >= 0
+            && (bindings->flags[body.bindingIndex] & BindingTable::Dormant);
+    }
+
+    bool Box2DPhysicsSystem::IsOfInterest(float x, float y, float margin) const
+    {
+        for (const auto& region : regions) {
+            const float dx = x - region.center.x;
+            const float dy = y - region.center.y;
+            const float r = region.radius + margin;
+            if (dx * dx + dy * dy <= r * r) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Box2DPhysicsSystem::UpdateDormancy()
+    {
+        if (regions.empty()) {
+            ReactivateAll();
+            return;
+        }
+
+        auto& table = *bindings;
+        if (regionsChanged) {
+            // Any body might have entered or left a region.
+            regionsChanged = false;
+            const size_t n = table.Size();
+            for (size_t i = 0; i < n; ++i) {
+                UpdateDormancy(i);
+            }
+            return;
+        }
+
+        // Bodies at rest have been evaluated when they came to rest, see
+        // SettleBody, hence only active bodies might have crossed the
+        // border of a region. Deactivating moves the last active binding
+        // to the current slot.
+        size_t i = 0;
+        while (i < table.active.size()) {
+            const int idx = table.active[i];
+            UpdateDormancy(idx);
+            if (i < table.active.size() && table.active[i] == idx) {
+                ++i;
+            }
+        }
+    }
+
+    void Box2DPhysicsSystem::UpdateDormancy(size_t idx)
+    {
+        auto& table = *bindings;
+        if (table.types[idx] == CBody::Type::Static) {
+            return;
+        }
+
+        // The synced poses are dense and up to date for all non-static
+        // bodies, bodies at rest do not move.
+        const auto& pose = table.synced[idx];
+        if (table.flags[idx] & BindingTable::Dormant) {
+            if (IsOfInterest(pose.x, pose.y, 0)) {
+                Reactivate(idx);
+                return;
+            }
+
+            if (regionMode == RegionMode::Sleep && table.bodies[idx]->IsAwake()) {
+                // Woken up by Box2D, e.g., by a body touching it.
+                table.bodies[idx]->SetAwake(false);
+                if (recorder) {
+                    recorder->WriteCommand(RecordTag::SetAwake, *table.bodies[idx], 0);
+                }
+            }
+            table.Deactivate(idx);
+        } else if (!IsOfInterest(pose.x, pose.y, regionMargin)) {
+            MakeDormant(idx);
+        }
+    }
+
+    void Box2DPhysicsSystem::SettleBody(size_t idx)
+    {
+        bindings->Deactivate(idx);
+
+        // Bodies at rest are not visited by UpdateDormancy unless regions
+        // change, hence they are evaluated when they come to rest.
+        if (!regions.empty()) {
+            UpdateDormancy(idx);
+        }
+    }
+
+    void Box2DPhysicsSystem::MakeDormant(size_t idx)
+    {
+        auto& table = *bindings;
+        b2Body* body = table.bodies[idx];
+
+        table.flags[idx] |= BindingTable::Dormant;
+        if (body->IsAwake()) {
+            table.flags[idx] |= BindingTable::WasAwake;
+        }
+        ++numDormant;
+
+        switch (regionMode) {
+        case RegionMode::Sleep:
+            body->SetAwake(false);
+            if (recorder) {
+                recorder->WriteCommand(RecordTag::SetAwake, *body, 0);
+            }
+            break;
+
+        case RegionMode::Disable:
+            body->SetEnabled(false);
+            if (recorder) {
+                recorder->WriteCommand(RecordTag::SetEnabled, *body, 0);
+            }
+            break;
+        }
+
+        // Dormant bodies do not move.
+        const b2Vec2& p = body->GetPosition();
+        table.previous[idx] = {p.x, p.y, body->GetAngle()};
+        table.Deactivate(idx);
+    }
+
+    void Box2DPhysicsSystem::Reactivate(size_t idx)
+    {
+        auto& table = *bindings;
+        b2Body* body = table.bodies[idx];
+
+        switch (regionMode) {
+        case RegionMode::Sleep:
+            if (table.flags[idx] & BindingTable::WasAwake) {
+                body->SetAwake(true);
+                if (recorder) {
+                    recorder->WriteCommand(RecordTag::SetAwake, *body, 1);
+                }
+            }
+            break;
+
+        case RegionMode::Disable:
+            // Bodies disabled by the application remain disabled.
+            if (table.components[idx]->IsEnabled()) {
+                body->SetEnabled(true);
+                if (recorder) {
+                    recorder->WriteCommand(RecordTag::SetEnabled, *body, 1);
+                }
+            }
+            break;
+        }
+
+        table.flags[idx] &= ~(BindingTable::Dormant | BindingTable::WasAwake);
+        --numDormant;
+        table.Activate(idx);
+    }
+
+    void Box2DPhysicsSystem::ReactivateAll()
+    {
+        if (numDormant == 0) {
+            return;
+        }
+
+        const size_t n = bindings->Size();
+        for (size_t i = 0; i < n && numDormant > 0; ++i) {
+            if (bindings->flags[i] & BindingTable::Dormant) {
+                Reactivate(i);
+            }
+        }
+    }
+
+} // end of namespace
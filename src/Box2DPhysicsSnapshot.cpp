@@ -0,0 +1,315 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "Box2DPhysicsSystem.h"
+#include "CBox2DBody.h"
+#include "BindingTable.h"
+#include "StepRecorder.h"
+
+// AST-Utilities includes
+#include <Suite2D/CPose.h>
+
+// Box2D includes
+#include <box2d/box2d.h>
+
+// C++ Standard Library includes
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+
+namespace astu::suite2d {
+
+    /** Identifies snapshots, 'B2SS' in little-endian byte order. */
+    static const uint32_t SNAPSHOT_MAGIC = 0x53533242;
+
+    /** The version of the snapshot format. */
+    static const uint16_t SNAPSHOT_VERSION = 2;
+
+    /** The body has been awake. */
+    static const uint8_t BODY_AWAKE = 0x01;
+
+    /**
+     * Layout of snapshots, all values in native byte order:
+     *
+     * Header:  magic (u32), version (u16), reserved (u16), accumulator (f32),
+     *          number of bodies (u32), number of contacts (u32)
+     * Body:    entity (u64), x, y, angle, vx, vy, w (f32), flags (u8)
+     * Contact: entity A, entity B (u64), binding A, binding B (u32),
+     *          fixture A, child A, fixture B, child B (u16), number of
+     *          points (u8), followed by id (u32), normal impulse, tangent
+     *          impulse (f32) per point
+     *
+     * The binding indices at saving time are hints, which spare the
+     * lookup of entities as long as bindings keep their order.
+     */
+    static const size_t HEADER_SIZE = 4 + 2 + 2 + 4 + 4 + 4;
+    static const size_t BODY_SIZE = 8 + 6 * 4 + 1;
+    static const size_t CONTACT_SIZE = 2 * 8 + 2 * 4 + 4 * 2 + 1;
+    static const size_t POINT_SIZE = 4 + 2 * 4;
+
+    /**
+     * Writes a value to a buffer and advances the write position.
+     */
+    template <typename T>
+    static inline void Put(uint8_t*& dst, const T& value)
+    {
+        memcpy(dst, &value, sizeof(T));
+        dst += sizeof(T);
+    }
+
+    /**
+     * Reads a value from a buffer and advances the read position.
+     */
+    template <typename T>
+    static inline T Get(const uint8_t*& src, const uint8_t* end)
+    {
+        if (static_cast<size_t>(end - src) < sizeof(T)) {
+            throw std::runtime_error("Physics snapshot is truncated");
+        }
+        T value;
+        memcpy(&value, src, sizeof(T));
+        src += sizeof(T);
+        return value;
+    }
+
+    /**
+     * Returns the body component a Box2D body has been created for.
+     */
+    static inline CBox2DBody& GetComponent(const b2Body& body)
+    {
+        return *reinterpret_cast<CBox2DBody*>(body.GetUserData().pointer);
+    }
+
+    void Box2DPhysicsSystem::SaveSnapshot(PhysicsSnapshot& snapshot)
+    {
+        WaitForStep();
+        FlushDespawns();
+        FlushSpawns();
+
+        auto& table = *bindings;
+        auto& data = snapshot.data;
+
+        // Upper bound, shrunk once the actual size is known.
+        data.resize(HEADER_SIZE + table.Size() * BODY_SIZE 
+            + world->GetContactCount() * (CONTACT_SIZE + b2_maxManifoldPoints * POINT_SIZE));
+
+        uint8_t* dst = data.data() + HEADER_SIZE;
+        uint32_t numBodies = 0;
+        for (size_t i = 0; i < table.Size(); ++i) {
+            if (table.types[i] == CBody::Type::Static) {
+                continue;
+            }
+
+            const b2Body& body = *table.bodies[i];
+            const b2Vec2& p = body.GetPosition();
+            const b2Vec2& v = body.GetLinearVelocity();
+            Put<uint64_t>(dst, reinterpret_cast<uintptr_t>(table.entities[i]));
+            Put(dst, p.x);
+            Put(dst, p.y);
+            Put(dst, body.GetAngle());
+            Put(dst, v.x);
+            Put(dst, v.y);
+            Put(dst, body.GetAngularVelocity());
+            Put<uint8_t>(dst, body.IsAwake() ? BODY_AWAKE : 0);
+            ++numBodies;
+        }
+
+        uint32_t numContacts = 0;
+        for (auto contact = world->GetContactList(); contact; contact = contact->GetNext()) {
+            if (!contact->IsTouching()) {
+                continue;
+            }
+
+            const b2Fixture* fixtureA = contact->GetFixtureA();
+            const b2Fixture* fixtureB = contact->GetFixtureB();
+            const auto& compA = GetComponent(*fixtureA->GetBody());
+            const auto& compB = GetComponent(*fixtureB->GetBody());
+            const b2Manifold& manifold = *contact->GetManifold();
+
+            Put<uint64_t>(dst, reinterpret_cast<uintptr_t>(table.entities[compA.bindingIndex]));
+            Put<uint64_t>(dst, reinterpret_cast<uintptr_t>(table.entities[compB.bindingIndex]));
+            Put(dst, static_cast<uint32_t>(compA.bindingIndex));
+            Put(dst, static_cast<uint32_t>(compB.bindingIndex));
+            Put(dst, GetFixtureIndex(*fixtureA));
+            Put(dst, static_cast<uint16_t>(contact->GetChildIndexA()));
+            Put(dst, GetFixtureIndex(*fixtureB));
+            Put(dst, static_cast<uint16_t>(contact->GetChildIndexB()));
+            Put(dst, static_cast<uint8_t>(manifold.pointCount));
+            for (int32 j = 0; j < manifold.pointCount; ++j) {
+                Put(dst, manifold.points[j].id.key);
+                Put(dst, manifold.points[j].normalImpulse);
+                Put(dst, manifold.points[j].tangentImpulse);
+            }
+            ++numContacts;
+        }
+        data.resize(dst - data.data());
+
+        dst = data.data();
+        Put(dst, SNAPSHOT_MAGIC);
+        Put(dst, SNAPSHOT_VERSION);
+        Put<uint16_t>(dst, 0);
+        Put(dst, accumulator);
+        Put(dst, numBodies);
+        Put(dst, numContacts);
+    }
+
+    void Box2DPhysicsSystem::RestoreSnapshot(const PhysicsSnapshot& snapshot)
+    {
+        WaitForStep();
+        FlushDespawns();
+        FlushSpawns();
+
+        const uint8_t* src = snapshot.data.data();
+        const uint8_t* end = src + snapshot.data.size();
+        if (Get<uint32_t>(src, end) != SNAPSHOT_MAGIC || Get<uint16_t>(src, end) != SNAPSHOT_VERSION) {
+            throw std::runtime_error("Invalid physics snapshot");
+        }
+        Get<uint16_t>(src, end);
+        float savedAccumulator = Get<float>(src, end);
+        uint32_t numBodies = Get<uint32_t>(src, end);
+        uint32_t numContacts = Get<uint32_t>(src, end);
+
+        auto& table = *bindings;
+        bool lookupValid = false;
+
+        // Bindings usually keep their order between saving and restoring,
+        // the lookup table is only built if they do not.
+        auto findBinding = [&](uint64_t key, size_t hint) -> int {
+            auto entity = reinterpret_cast<const Entity*>(static_cast<uintptr_t>(key));
+            if (hint < table.Size() && table.entities[hint] == entity) {
+                return static_cast<int>(hint);
+            }
+            if (!lookupValid) {
+                bindingLookup.clear();
+                for (size_t i = 0; i < table.Size(); ++i) {
+                    bindingLookup.emplace_back(table.entities[i], static_cast<int>(i));
+                }
+                sort(bindingLookup.begin(), bindingLookup.end());
+                lookupValid = true;
+            }
+            auto it = lower_bound(bindingLookup.begin(), bindingLookup.end(),
+                make_pair(entity, numeric_limits<int>::min()));
+            return it != bindingLookup.end() && it->first == entity ? it->second : -1;
+        };
+
+        size_t hint = 0;
+        for (uint32_t i = 0; i < numBodies; ++i) {
+            uint64_t key = Get<uint64_t>(src, end);
+            BodyPose pose;
+            pose.x = Get<float>(src, end);
+            pose.y = Get<float>(src, end);
+            pose.angle = Get<float>(src, end);
+            b2Vec2 v;
+            v.x = Get<float>(src, end);
+            v.y = Get<float>(src, end);
+            float w = Get<float>(src, end);
+            uint8_t flags = Get<uint8_t>(src, end);
+
+            // Static bodies are not saved, skip them to find the next hint.
+            while (hint < table.Size() && table.types[hint] == CBody::Type::Static) {
+                ++hint;
+            }
+            int idx = findBinding(key, hint);
+            hint = (idx >= 0 ? idx : hint) + 1;
+            if (idx < 0) {
+                continue;
+            }
+
+            b2Body& body = *table.bodies[idx];
+            const b2Vec2& p = body.GetPosition();
+            if (p.x != pose.x || p.y != pose.y || body.GetAngle() != pose.angle) {
+                body.SetTransform(b2Vec2(pose.x, pose.y), pose.angle);
+            }
+
+            // Contacts not touching when the snapshot has been saved must not
+            // warm-start the next step, saved contacts are restored below.
+            for (auto ce = body.GetContactList(); ce; ce = ce->next) {
+                b2Manifold& manifold = *ce->contact->GetManifold();
+                for (int32 j = 0; j < manifold.pointCount; ++j) {
+                    manifold.points[j].normalImpulse = 0;
+                    manifold.points[j].tangentImpulse = 0;
+                }
+                manifold.pointCount = 0;
+            }
+
+            // Putting a body to sleep clears its velocity.
+            body.SetAwake((flags & BODY_AWAKE) != 0);
+            if (flags & BODY_AWAKE) {
+                body.SetLinearVelocity(v);
+                body.SetAngularVelocity(w);
+            }
+
+            auto& tx = table.poses[idx]->transform;
+            tx.SetTranslation(pose.x, pose.y);
+            tx.SetRotation(pose.angle);
+            table.synced[idx] = pose;
+            table.previous[idx] = pose;
+            table.flags[idx] &= ~BindingTable::Interpolated;
+            table.Activate(idx);
+        }
+
+        for (uint32_t i = 0; i < numContacts; ++i) {
+            uint64_t keyA = Get<uint64_t>(src, end);
+            uint64_t keyB = Get<uint64_t>(src, end);
+            uint32_t hintA = Get<uint32_t>(src, end);
+            uint32_t hintB = Get<uint32_t>(src, end);
+            uint16_t fixtureA = Get<uint16_t>(src, end);
+            uint16_t childA = Get<uint16_t>(src, end);
+            uint16_t fixtureB = Get<uint16_t>(src, end);
+            uint16_t childB = Get<uint16_t>(src, end);
+            uint8_t pointCount = Get<uint8_t>(src, end);
+            if (pointCount > b2_maxManifoldPoints) {
+                throw std::runtime_error("Invalid physics snapshot");
+            }
+
+            b2ManifoldPoint points[b2_maxManifoldPoints];
+            for (uint8_t j = 0; j < pointCount; ++j) {
+                points[j].id.key = Get<uint32>(src, end);
+                points[j].normalImpulse = Get<float>(src, end);
+                points[j].tangentImpulse = Get<float>(src, end);
+            }
+
+            int idxA = findBinding(keyA, hintA);
+            int idxB = findBinding(keyB, hintB);
+            if (idxA < 0 || idxB < 0) {
+                continue;
+            }
+
+            const b2Body* bodyB = table.bodies[idxB];
+            for (auto ce = table.bodies[idxA]->GetContactList(); ce; ce = ce->next) {
+                b2Contact* contact = ce->contact;
+                if (ce->other != bodyB 
+                    || contact->GetFixtureA()->GetBody() != table.bodies[idxA]
+                    || contact->GetChildIndexA() != childA
+                    || contact->GetChildIndexB() != childB
+                    || GetFixtureIndex(*contact->GetFixtureA()) != fixtureA
+                    || GetFixtureIndex(*contact->GetFixtureB()) != fixtureB) 
+                {
+                    continue;
+                }
+
+                // Only ids and impulses are used to warm-start the next step.
+                b2Manifold& manifold = *contact->GetManifold();
+                manifold.pointCount = pointCount;
+                for (uint8_t j = 0; j < pointCount; ++j) {
+                    manifold.points[j].id = points[j].id;
+                    manifold.points[j].normalImpulse = points[j].normalImpulse;
+                    manifold.points[j].tangentImpulse = points[j].tangentImpulse;
+                }
+                break;
+            }
+        }
+
+        accumulator = savedAccumulator;
+    }
+
+} // end of namespace
@@ -9,6 +9,16 @@
 #include "Box2DPhysicsSystem.h"
 #include "CBox2DBody.h"
 #include "CBox2DColliders.h"
+#include "BindingTable.h"
+#include "WorkerPool.h"
+#include "ShapeCache.h"
+#include "Profiler.h"
+#include "StepRecorder.h"
+#include "AsyncStepper.h"
+#include "Box2DGlobals.h"
+#include "CommandQueue.h"
+#include "SensorContact.h"
+#include "SolverController.h"
 
 // AST-Utilities includes
 #include <Suite2D/CPose.h>
@@ -18,6 +28,9 @@
 
 // C++ Standard Libraries includes
 #include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <typeinfo>
 
 using namespace std;
 
@@ -35,19 +48,18 @@ namespace astu::suite2d {
 
         // Inherited via b2ContactListener
         virtual void BeginContact(b2Contact* contact) override { 
-            auto entityA = reinterpret_cast<EntityComponent*>(
-                contact->GetFixtureA()->GetUserData().pointer
-            );
-
-            auto entityB = reinterpret_cast<EntityComponent*>(
-                contact->GetFixtureB()->GetUserData().pointer
-            );
-
-            context.HandleCollision(entityA->GetParent(), entityB->GetParent());
+            context.RecordContact(*contact, ContactEvent::Type::Begin);
         }
 
         virtual void EndContact(b2Contact* contact) override { 
-            // Intentionally left empty.
+            context.RecordContact(*contact, ContactEvent::Type::End);
+            context.contactImpacts.erase(contact);
+        }
+
+        virtual void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override {
+            if (context.impactEvents) {
+                context.RecordImpact(*contact, *impulse);
+            }
         }
 
     private:
@@ -55,6 +67,54 @@ namespace astu::suite2d {
         Box2DPhysicsSystem& context;
     };
 
+    /**
+     * Converts a body type to the corresponding Box2D body type.
+     *
+     * @param type  the body type
+     * @return the Box2D body type
+     */
+    static inline b2BodyType ToBox2DType(CBody::Type type)
+    {
+        switch (type) {
+        case CBody::Type::Static:
+            return b2_staticBody;
+        case CBody::Type::Kinematic:
+            return b2_kinematicBody;
+        case CBody::Type::Dynamic:
+        default:
+            return b2_dynamicBody;
+        }
+    }
+
+    /**
+     * Returns the Box2D interface of a collider.
+     *
+     * Collider components are defined by AST-Utilities without a virtual
+     * accessor for the Box2D interface, hence this relies on RTTI. The
+     * colliders created by this system are identified by comparing their
+     * exact type, which avoids searching the class hierarchy, other
+     * colliders fall back to a cross-cast.
+     *
+     * @param col   the collider
+     * @return the Box2D collider or `nullptr` if not created for Box2D
+     */
+    static inline IBox2DCollider* ToBox2DCollider(CBodyCollider& col)
+    {
+        const type_info& type = typeid(col);
+        if (type == typeid(CBox2DCircleCollider)) {
+            return &static_cast<CBox2DCircleCollider&>(col);
+        } else if (type == typeid(CBox2DPolygonCollider)) {
+            return &static_cast<CBox2DPolygonCollider&>(col);
+        } else if (type == typeid(CBox2DChainCollider)) {
+            return &static_cast<CBox2DChainCollider&>(col);
+        } else if (type == typeid(CBox2DEdgeCollider)) {
+            return &static_cast<CBox2DEdgeCollider&>(col);
+        } else if (type == typeid(CBox2DCompoundCollider)) {
+            return &static_cast<CBox2DCompoundCollider&>(col);
+        }
+        return dynamic_cast<IBox2DCollider*>(&col);
+    }
+
     const EntityFamily Box2DPhysicsSystem::FAMILY = EntityFamily::Create<CBox2DBody, CPose>();
 
     Box2DPhysicsSystem::Box2DPhysicsSystem(int updatePriority)
@@ -64,8 +124,44 @@ namespace astu::suite2d {
         , EntityListener(FAMILY)
         , velocityIterations(8)
         , positionIterations(3)
+        , fixedTimeStep(false)
+        , stepSize(1.0f / 60.0f)
+        , maxSubSteps(8)
+        , accumulator(0)
+        , interpolation(false)
+        , alwaysPushPoses(false)
         , gravity(0, 0)
         , contactListener(make_unique<ContactListener>(*this))
+        , collisionSignaling(true)
+        , impactEvents(false)
+        , impactThreshold(1.0f)
+        , impactUpdate(0)
+        , workerThreads(0)
+        , parallelSyncThreshold(10000)
+        , parallelSyncGrain(4096)
+        , bindings(make_unique<BindingTable>())
+        , shapeCache(make_unique<ShapeCache>())
+        , group(nullptr)
+        , pendingSteps(0)
+        , pendingStepSize(0)
+        , deferredSpawning(false)
+        , profileWindow(120)
+        , stateHashing(false)
+        , stateHash(0)
+        , sleepingAllowed(true)
+        , regionMode(RegionMode::Sleep)
+        , regionMargin(1.0f)
+        , numDormant(0)
+        , regionsChanged(true)
+        , asyncStep(false)
+        , stepPending(false)
+        , deferredCommands(false)
+        , commandQueue(make_unique<CommandQueue>())
+        , reportedSensorEvents(0)
+        , worldBlockPeak(0)
+        , worldNodePeak(0)
+        , memoryPeak(0)
+        , continuousPhysics(true)
     {
         // Intentionally left empty.
     }
@@ -80,6 +176,7 @@ namespace astu::suite2d {
         if (iterations <= 0) {
             throw std::logic_error("Position iterations must be greater zero");
         }
+        WaitForStep();
         positionIterations = iterations;
         return *this;
     }
@@ -89,17 +186,367 @@ namespace astu::suite2d {
         if (iterations <= 0) {
             throw std::logic_error("Velocity iterations must be greater zero");
         }
+        WaitForStep();
         velocityIterations = iterations;
         return *this;
     }
 
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetFixedTimeStep(bool b)
+    {
+        fixedTimeStep = b;
+        accumulator = 0;
+        return *this;
+    }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetStepSize(float dt)
+    {
+        if (dt <= 0) {
+            throw std::logic_error("Step size must be greater zero");
+        }
+        stepSize = dt;
+        return *this;
+    }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetMaxSubSteps(int n)
+    {
+        if (n <= 0) {
+            throw std::logic_error("Maximum number of sub-steps must be greater zero");
+        }
+        maxSubSteps = n;
+        return *this;
+    }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetInterpolation(bool b)
+    {
+        interpolation = b;
+        return *this;
+    }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetContinuousPhysics(bool b)
+    {
+        continuousPhysics = b;
+        if (world) {
+            WaitForStep();
+            ApplySolverLevel();
+        }
+        return *this;
+    }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetAdaptiveSolver(bool b)
+    {
+        if (b == IsAdaptiveSolver()) {
+            return *this;
+        }
+
+        WaitForStep();
+        solverController = b ? make_unique<SolverController>(solverBudget) : nullptr;
+        if (world) {
+            ApplySolverLevel();
+        }
+        return *this;
+    }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetSolverBudget(const SolverBudget& budget)
+    {
+        if (budget.stepTime <= 0) {
+            throw std::logic_error("Step time budget must be greater zero");
+        }
+        if (budget.minVelocityIterations <= 0 || budget.minPositionIterations <= 0) {
+            throw std::logic_error("Minimum solver iterations must be greater zero");
+        }
+        if (budget.minSubSteps <= 0) {
+            throw std::logic_error("Minimum number of sub-steps must be greater zero");
+        }
+        if (budget.hysteresis < 0 || budget.hysteresis >= 1) {
+            throw std::logic_error("Solver hysteresis must be within [0, 1)");
+        }
+        if (budget.settleSteps <= 0) {
+            throw std::logic_error("Number of settle steps must be greater zero");
+        }
+
+        WaitForStep();
+        solverBudget = budget;
+        if (solverController) {
+            solverController = make_unique<SolverController>(solverBudget);
+            if (world) {
+                ApplySolverLevel();
+            }
+        }
+        return *this;
+    }
+
+    SolverLevel Box2DPhysicsSystem::GetBestSolverLevel() const
+    {
+        SolverLevel result;
+        result.velocityIterations = velocityIterations;
+        result.positionIterations = positionIterations;
+        result.continuousPhysics = continuousPhysics;
+        result.maxSubSteps = fixedTimeStep ? maxSubSteps : 1;
+        return result;
+    }
+
+    void Box2DPhysicsSystem::ApplySolverLevel()
+    {
+        const SolverLevel best = GetBestSolverLevel();
+        solverLevel = solverController ? solverController->GetSettings(best) : best;
+        if (world->GetContinuousPhysics() != solverLevel.continuousPhysics) {
+            world->SetContinuousPhysics(solverLevel.continuousPhysics);
+            if (recorder) {
+                recorder->WriteContinuousPhysics(solverLevel.continuousPhysics);
+            }
+        }
+    }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetAlwaysPushPoses(bool b)
+    {
+        alwaysPushPoses = b;
+        return *this;
+    }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetContactEventCapacity(size_t n)
+    {
+        contactEvents.reserve(n);
+        return *this;
+    }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetCollisionSignaling(bool b)
+    {
+        collisionSignaling = b;
+        return *this;
+    }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetImpactEvents(bool b)
+    {
+        impactEvents = b;
+        return *this;
+    }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetImpactThreshold(float threshold)
+    {
+        if (threshold < 0) {
+            throw std::logic_error("Impact threshold must not be negative");
+        }
+        impactThreshold = threshold;
+        return *this;
+    }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetWorkerThreads(unsigned int n)
+    {
+        workerThreads = n;
+        if (IsStarted()) {
+            workerPool = n > 0 ? make_unique<WorkerPool>(n) : nullptr;
+        }
+        return *this;
+    }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetParallelSyncThreshold(size_t n)
+    {
+        parallelSyncThreshold = n;
+        return *this;
+    }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetParallelSyncGrain(size_t n)
+    {
+        if (n == 0) {
+            throw std::logic_error("Parallel sync grain must be greater zero");
+        }
+        parallelSyncGrain = n;
+        return *this;
+    }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetProfiling(bool b)
+    {
+        if (b == IsProfiling()) {
+            return *this;
+        }
+
+        WaitForStep();
+        stepStats = StepStats();
+        if (b) {
+            profiler = make_unique<Profiler>(profileWindow);
+            if (!traceFile.empty()) {
+                profiler->OpenTrace(traceFile);
+            }
+        } else {
+            profiler = nullptr;
+        }
+        return *this;
+    }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetProfileWindow(size_t n)
+    {
+        if (n == 0) {
+            throw std::logic_error("Profile window must be greater zero");
+        }
+        profileWindow = n;
+        if (profiler) {
+            WaitForStep();
+            // Start over with the new window size.
+            profiler = nullptr;
+            SetProfiling(true);
+        }
+        return *this;
+    }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetTraceFile(const std::string& filename)
+    {
+        traceFile = filename;
+        if (profiler) {
+            WaitForStep();
+            if (traceFile.empty()) {
+                profiler->CloseTrace();
+            } else {
+                profiler->OpenTrace(traceFile);
+            }
+        }
+        return *this;
+    }
+
+    ProfileSummary Box2DPhysicsSystem::GetProfileSummary(ProfileMetric metric) const
+    {
+        return profiler ? profiler->Summarize(metric) : ProfileSummary();
+    }
+
     PhysicsSystem& Box2DPhysicsSystem::SetGravityVector(float gx, float gy) {
         gravity.Set(gx, gy);
         if (IsStarted() && world) {
+            WaitForStep();
             world->SetGravity(b2Vec2(gravity.x, gravity.y));
+            if (recorder) {
+                recorder->WriteGravity(world->GetGravity());
+            }
         }
         return *this;
     }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetStateHashing(bool b)
+    {
+        stateHashing = b;
+        return *this;
+    }
+
+    void Box2DPhysicsSystem::StartRecording(const std::string& filename)
+    {
+        if (!IsStarted() || !world) {
+            throw std::logic_error("Unable to start recording, physics system not started");
+        }
+
+        // Pending bodies are part of the initial state of the recording.
+        FinishAsyncStep();
+        recorder = nullptr;
+        FlushDespawns();
+        FlushSpawns();
+
+        // The old world provides the state of the new bodies and contacts.
+        auto& table = *bindings;
+        auto oldWorld = std::move(world);
+        const vector<b2Body*> oldBodies(table.bodies);
+        CreateWorld();
+        for (size_t i = 0; i < table.Size(); ++i) {
+            const b2Body& old = *oldBodies[i];
+            b2BodyDef def;
+            def.type = old.GetType();
+            def.position = old.GetPosition();
+            def.angle = old.GetAngle();
+            def.linearVelocity = old.GetLinearVelocity();
+            def.angularVelocity = old.GetAngularVelocity();
+            def.linearDamping = old.GetLinearDamping();
+            def.angularDamping = old.GetAngularDamping();
+            def.gravityScale = old.GetGravityScale();
+            def.fixedRotation = old.IsFixedRotation();
+            def.bullet = old.IsBullet();
+            def.awake = old.IsAwake();
+            def.allowSleep = old.IsSleepingAllowed();
+            def.enabled = old.IsEnabled();
+            def.userData = old.GetUserData();
+            table.bodies[i] = world->CreateBody(&def);
+            table.components[i]->boxBody = table.bodies[i];
+
+            // Overlaps are rebuilt from the new contacts below.
+            auto& entity = *table.entities[i];
+            if (entity.HasComponent<CBodyCollider>()) {
+                IBox2DCollider* boxCol = ToBox2DCollider(entity.GetComponent<CBodyCollider>());
+                if (boxCol) {
+                    boxCol->ClearOverlaps();
+                    boxCol->ReleaseFixtures();
+                }
+            }
+            AddFixture(entity, *table.bodies[i]);
+        }
+
+        recorder = make_unique<StepRecorder>(filename, *world, capacity);
+
+        // A step of zero length creates the contacts of touching bodies,
+        // they have begun before and must not be reported again.
+        world->SetContactListener(nullptr);
+        world->Step(0, solverLevel.velocityIterations, solverLevel.positionIterations);
+        world->SetContactListener(contactListener.get());
+        stateHash = HashWorldState(*world);
+        recorder->WriteStep(0, solverLevel.velocityIterations, solverLevel.positionIterations, stateHash);
+
+        for (auto contact = world->GetContactList(); contact; contact = contact->GetNext()) {
+            if (contact->IsTouching()) {
+                TransferContact(*contact, oldBodies);
+            }
+        }
+    }
+
+    void Box2DPhysicsSystem::TransferContact(b2Contact& contact, const vector<b2Body*>& oldBodies)
+    {
+        b2Fixture& fixtureA = *contact.GetFixtureA();
+        b2Fixture& fixtureB = *contact.GetFixtureB();
+        if (fixtureA.IsSensor() || fixtureB.IsSensor()) {
+            if (fixtureA.IsSensor()) {
+                reinterpret_cast<IBox2DCollider*>(fixtureA.GetUserData().pointer)->AddOverlap(*GetEntity(fixtureB));
+            }
+            if (fixtureB.IsSensor()) {
+                reinterpret_cast<IBox2DCollider*>(fixtureB.GetUserData().pointer)->AddOverlap(*GetEntity(fixtureA));
+            }
+            return;
+        }
+
+        auto& compA = *reinterpret_cast<CBox2DBody*>(fixtureA.GetBody()->GetUserData().pointer);
+        auto& compB = *reinterpret_cast<CBox2DBody*>(fixtureB.GetBody()->GetUserData().pointer);
+        const b2Body* oldA = oldBodies[compA.bindingIndex];
+        const b2Body* oldB = oldBodies[compB.bindingIndex];
+        const uint16_t indexA = GetFixtureIndex(fixtureA);
+        const uint16_t indexB = GetFixtureIndex(fixtureB);
+
+        for (auto ce = oldA->GetContactList(); ce; ce = ce->next) {
+            const b2Contact& old = *ce->contact;
+            if (ce->other != oldB
+                || old.GetFixtureA()->GetBody() != oldA
+                || old.GetChildIndexA() != contact.GetChildIndexA()
+                || old.GetChildIndexB() != contact.GetChildIndexB()
+                || GetFixtureIndex(*old.GetFixtureA()) != indexA
+                || GetFixtureIndex(*old.GetFixtureB()) != indexB)
+            {
+                continue;
+            }
+
+            // Impulses are matched by contact feature, as Box2D does.
+            b2Manifold& manifold = *contact.GetManifold();
+            const b2Manifold& oldManifold = *old.GetManifold();
+            for (int32 i = 0; i < manifold.pointCount; ++i) {
+                auto& point = manifold.points[i];
+                for (int32 j = 0; j < oldManifold.pointCount; ++j) {
+                    if (oldManifold.points[j].id.key == point.id.key) {
+                        point.normalImpulse = oldManifold.points[j].normalImpulse;
+                        point.tangentImpulse = oldManifold.points[j].tangentImpulse;
+                        break;
+                    }
+                }
+            }
+            recorder->WriteContactImpulses(contact);
+            return;
+        }
+    }
+
+    void Box2DPhysicsSystem::StopRecording()
+    {
+        WaitForStep();
+        recorder = nullptr;
+    }
     
     const Vector2f& Box2DPhysicsSystem::GetGravityVector() const
     {
@@ -121,6 +568,21 @@ namespace astu::suite2d {
         return make_shared<CBox2DPolygonCollider>();
     }
 
+    shared_ptr<CChainCollider> Box2DPhysicsSystem::CreateChainCollider()
+    {
+        return make_shared<CBox2DChainCollider>();
+    }
+
+    shared_ptr<CCompoundCollider> Box2DPhysicsSystem::CreateCompoundCollider()
+    {
+        return make_shared<CBox2DCompoundCollider>();
+    }
+
+    shared_ptr<CEdgeCollider> Box2DPhysicsSystem::CreateEdgeCollider()
+    {
+        return make_shared<CBox2DEdgeCollider>();
+    }
+
     void Box2DPhysicsSystem::HandleCollision(std::shared_ptr<Entity> a, std::shared_ptr<Entity> b)
     {
         if (collisionSignals) {
@@ -128,80 +590,757 @@ namespace astu::suite2d {
         }
     }
 
+    void Box2DPhysicsSystem::RecordContact(b2Contact& contact, ContactEvent::Type type)
+    {
+        b2Fixture* fixtureA = contact.GetFixtureA();
+        b2Fixture* fixtureB = contact.GetFixtureB();
+        auto& bodyA = *reinterpret_cast<CBox2DBody*>(fixtureA->GetBody()->GetUserData().pointer);
+        auto& bodyB = *reinterpret_cast<CBox2DBody*>(fixtureB->GetBody()->GetUserData().pointer);
+        auto& colliderA = *reinterpret_cast<IBox2DCollider*>(fixtureA->GetUserData().pointer);
+        auto& colliderB = *reinterpret_cast<IBox2DCollider*>(fixtureB->GetUserData().pointer);
+
+        // Box2D wakes up both bodies when a contact begins or ends touching.
+        ActivateBody(bodyA);
+        ActivateBody(bodyB);
+
+        if (fixtureA->IsSensor() || fixtureB->IsSensor()) {
+            const bool begin = type == ContactEvent::Type::Begin;
+            RecordSensorContact(*fixtureA, *fixtureB, begin);
+            RecordSensorContact(*fixtureB, *fixtureA, begin);
+        }
+
+        // Contacts also end when bodies get destroyed, outside of a step.
+        // Those are not reported, since the entity is about to vanish.
+        if (!world->IsLocked()) {
+            return;
+        }
+
+        ContactEvent event;
+        event.type = type;
+        event.childIndexA = contact.GetChildIndexA();
+        event.childIndexB = contact.GetChildIndexB();
+        event.entityA = GetEntity(*fixtureA);
+        event.entityB = GetEntity(*fixtureB);
+        event.colliderA = &colliderA.GetRootCollider();
+        event.colliderB = &colliderB.GetRootCollider();
+        event.subColliderA = &colliderA.GetBodyCollider();
+        event.subColliderB = &colliderB.GetBodyCollider();
+
+        if (contact.GetManifold()->pointCount > 0) {
+            b2WorldManifold worldManifold;
+            contact.GetWorldManifold(&worldManifold);
+            event.normal.Set(worldManifold.normal.x, worldManifold.normal.y);
+            event.point.Set(worldManifold.points[0].x, worldManifold.points[0].y);
+        } else {
+            event.normal.Set(0, 0);
+            event.point.Set(0, 0);
+        }
+
+        contactEvents.push_back(event);
+    }
+
+    void Box2DPhysicsSystem::RecordSensorContact(b2Fixture& fixture, b2Fixture& other, bool begin)
+    {
+        if (!fixture.IsSensor()) {
+            return;
+        }
+
+        SensorContact contact;
+        contact.sensor = reinterpret_cast<IBox2DCollider*>(fixture.GetUserData().pointer);
+        contact.sensorEntity = GetEntity(fixture);
+        contact.entity = GetEntity(other);
+        contact.begin = begin;
+
+        if (world->IsLocked()) {
+            sensorContacts.push_back(contact);
+        } else {
+            // Ended by destroying or disabling a body, not within a step.
+            UpdateSensor(contact);
+        }
+    }
+
+    void Box2DPhysicsSystem::UpdateSensor(const SensorContact& contact)
+    {
+        auto& sensor = *contact.sensor;
+        SensorEvent event;
+        if (contact.begin) {
+            if (!sensor.AddOverlap(*contact.entity)) {
+                return;
+            }
+            event.type = SensorEvent::Type::Enter;
+        } else {
+            if (!sensor.RemoveOverlap(*contact.entity)) {
+                return;
+            }
+            event.type = SensorEvent::Type::Exit;
+        }
+
+        event.sensorEntity = contact.sensorEntity;
+        event.sensor = &sensor.GetBodyCollider();
+        event.entity = contact.entity;
+        sensorEvents.push_back(event);
+    }
+
+    void Box2DPhysicsSystem::UpdateSensors()
+    {
+        for (const auto& contact : sensorContacts) {
+            UpdateSensor(contact);
+        }
+        sensorContacts.clear();
+    }
+
+    void Box2DPhysicsSystem::RecordImpact(b2Contact& contact, const b2ContactImpulse& impulse)
+    {
+        float maxNormal = 0;
+        float maxTangent = 0;
+        int32 maxPoint = 0;
+        for (int32 i = 0; i < impulse.count; ++i) {
+            if (impulse.normalImpulses[i] > maxNormal) {
+                maxNormal = impulse.normalImpulses[i];
+                maxPoint = i;
+            }
+            maxTangent = std::max(maxTangent, std::abs(impulse.tangentImpulses[i]));
+        }
+
+        // Separating contacts never report an impact.
+        if (maxNormal <= 0) {
+            return;
+        }
+
+        // Sub-steps and TOI sub-steps solve a contact several times per
+        // update, only the maximum impulse of the update counts.
+        auto& state = contactImpacts.try_emplace(&contact, ContactImpact{impactUpdate, 0, 0, -1}).first->second;
+        if (state.update != impactUpdate) {
+            state.previousPeak = state.peak;
+            state.peak = 0;
+            state.update = impactUpdate;
+            state.event = -1;
+        }
+        if (maxNormal <= state.peak) {
+            return;
+        }
+        state.peak = maxNormal;
+
+        b2Fixture* fixtureA = contact.GetFixtureA();
+        b2Fixture* fixtureB = contact.GetFixtureB();
+        auto& colliderA = *reinterpret_cast<IBox2DCollider*>(fixtureA->GetUserData().pointer);
+        auto& colliderB = *reinterpret_cast<IBox2DCollider*>(fixtureB->GetUserData().pointer);
+
+        float thresholdA = colliderA.GetImpactThreshold();
+        float thresholdB = colliderB.GetImpactThreshold();
+        float threshold;
+        if (thresholdA >= 0 && thresholdB >= 0) {
+            threshold = std::min(thresholdA, thresholdB);
+        } else if (thresholdA >= 0) {
+            threshold = thresholdA;
+        } else if (thresholdB >= 0) {
+            threshold = thresholdB;
+        } else {
+            threshold = impactThreshold;
+        }
+
+        // Contacts pushing harder than the threshold ever since, e.g.,
+        // heavy bodies at rest, have already been reported.
+        if (maxNormal < threshold || state.previousPeak >= threshold) {
+            return;
+        }
+
+        b2WorldManifold worldManifold;
+        contact.GetWorldManifold(&worldManifold);
+
+        ImpactEvent event;
+        event.childIndexA = contact.GetChildIndexA();
+        event.childIndexB = contact.GetChildIndexB();
+        event.entityA = GetEntity(*fixtureA);
+        event.entityB = GetEntity(*fixtureB);
+        event.colliderA = &colliderA.GetRootCollider();
+        event.colliderB = &colliderB.GetRootCollider();
+        event.subColliderA = &colliderA.GetBodyCollider();
+        event.subColliderB = &colliderB.GetBodyCollider();
+        event.normalImpulse = maxNormal;
+        event.tangentImpulse = maxTangent;
+        event.normal.Set(worldManifold.normal.x, worldManifold.normal.y);
+        event.point.Set(worldManifold.points[maxPoint].x, worldManifold.points[maxPoint].y);
+
+        // A stronger impulse later during the same update replaces the event.
+        if (state.event >= 0) {
+            impacts[state.event] = event;
+        } else {
+            state.event = static_cast<int>(impacts.size());
+            impacts.push_back(event);
+        }
+    }
+
+    Entity* Box2DPhysicsSystem::GetEntity(b2Fixture& fixture) const
+    {
+        auto& body = *reinterpret_cast<CBox2DBody*>(fixture.GetBody()->GetUserData().pointer);
+        return bindings->entities[body.bindingIndex];
+    }
+
+    void Box2DPhysicsSystem::DispatchCollisionSignals()
+    {
+        if (!collisionSignals || !collisionSignaling) {
+            return;
+        }
+
+        for (const auto& event : contactEvents) {
+            if (event.type == ContactEvent::Type::Begin) {
+                HandleCollision(event.colliderA->GetParent(), event.colliderB->GetParent());
+            }
+        }
+    }
+
     void Box2DPhysicsSystem::OnStartup() 
     {
         // Create physics world.
-        world = make_unique<b2World>(b2Vec2(gravity.x, gravity.y));
-        world->SetContactListener(contactListener.get());
+        memoryPeak = 0;
+        CreateWorld();
 
         collisionSignals = ASTU_GET_SERVICE_OR_NULL(CollisionSignalService);
+
+        if (workerThreads > 0) {
+            workerPool = make_unique<WorkerPool>(workerThreads);
+        }
+
+        if (asyncStep) {
+            PrepareConcurrentSteps();
+            stepper = make_unique<AsyncStepper>([this] { Simulate(); });
+        }
+    }
+
+    void Box2DPhysicsSystem::CreateWorld()
+    {
+        // The old world is released first, otherwise the memory of both
+        // worlds would be allocated at the same time.
+        world = nullptr;
+        contactImpacts.clear();
+        world = make_unique<b2World>(b2Vec2(gravity.x, gravity.y));
+        world->SetAllowSleeping(sleepingAllowed);
+        ApplySolverLevel();
+        worldBlockPeak = 0;
+        worldNodePeak = 0;
+        ReserveWorldCapacity();
+        world->SetContactListener(contactListener.get());
+        if (recorder) {
+            recorder->WriteCreateWorld(*world, capacity);
+        }
     }
 
     void Box2DPhysicsSystem::OnShutdown()
     {
+        // The results of a running step are discarded.
+        WaitForStep();
+        UnbindAll();
+        stepper = nullptr;
+        stepPending = false;
+
         // Release resources.
+        recorder = nullptr;
+        workerPool = nullptr;
         collisionSignals = nullptr;
         world = nullptr;
+        accumulator = 0;
+        shapeCache->Clear();
+    }
+
+    void Box2DPhysicsSystem::UnbindAll()
+    {
+        for (size_t i = 0; i < bindings->Size(); ++i) {
+            auto& body = *bindings->components[i];
+            body.DiscardPendingChanges();
+            body.boxBody = nullptr;
+            body.system = nullptr;
+
+            auto entity = bindings->entities[i];
+            if (entity->HasComponent<CBodyCollider>()) {
+                IBox2DCollider* boxCol = ToBox2DCollider(entity->GetComponent<CBodyCollider>());
+                if (boxCol) {
+                    boxCol->ClearOverlaps();
+                    boxCol->ReleaseFixtures();
+                }
+            }
+        }
+        bindings->Clear();
+        numDormant = 0;
+
+        // Pending despawns are bound and have been detached above.
+        pendingDespawns.clear();
+        pendingSpawns.clear();
+        sensorContacts.clear();
+        sensorEvents.clear();
+        publishedSensorEvents.clear();
+        reportedSensorEvents = 0;
+        contactEvents.clear();
+        impacts.clear();
+        publishedEvents.clear();
+        publishedImpacts.clear();
     }
 
     void Box2DPhysicsSystem::OnUpdate()
     {
+        if (group) {
+            // Stepped by the world group, concurrently with other worlds.
+            return;
+        }
+
+        if (asyncStep) {
+            UpdateAsync();
+            return;
+        }
+
+        BeginUpdate();
+        Simulate();
+        EndUpdate();
+    }
+
+    void Box2DPhysicsSystem::BeginUpdate()
+    {
+        Profiler::Clock::time_point start;
+        if (profiler) {
+            start = Profiler::Clock::now();
+        }
+
+        // Sensor events caused by removing bodies after the last update
+        // have not been reported yet.
+        contactEvents.clear();
+        impacts.clear();
+        ++impactUpdate;
+        sensorEvents.erase(sensorEvents.begin(), sensorEvents.begin() + reportedSensorEvents);
+        reportedSensorEvents = 0;
+
+        FlushDespawns();
+        FlushSpawns();
+
+        if (profiler) {
+            stepStats.spawnTime = profiler->EndPhase("Spawn", start);
+            start = Profiler::Clock::now();
+        }
+
         CollectTransforms();
-        world->Step(GetElapsedTimeF(), velocityIterations, positionIterations);
-        DeployTransforms();
+        ApplyCommands();
+        UpdateDormancy();
+
+        if (profiler) {
+            stepStats.collectTime = profiler->EndPhase("Collect", start);
+        }
+
+        ApplySolverLevel();
+        if (!fixedTimeStep) {
+            pendingSteps = 1;
+            pendingStepSize = GetElapsedTimeF();
+            return;
+        }
+
+        accumulator += GetElapsedTimeF();
+        int numSteps = static_cast<int>(accumulator / stepSize);
+        if (numSteps > solverLevel.maxSubSteps) {
+            // Discard the time we are unable to catch up with.
+            numSteps = solverLevel.maxSubSteps;
+            accumulator = numSteps * stepSize + std::fmod(accumulator, stepSize);
+        }
+        accumulator -= numSteps * stepSize;
+
+        pendingSteps = numSteps;
+        pendingStepSize = stepSize;
+    }
+
+    void Box2DPhysicsSystem::Simulate()
+    {
+        Profiler::Clock::time_point start;
+        if (profiler) {
+            start = Profiler::Clock::now();
+            stepStats.collideTime = 0;
+            stepStats.solveTime = 0;
+            stepStats.broadphaseTime = 0;
+            stepStats.solveTOITime = 0;
+        }
+
+        for (int i = 0; i < pendingSteps; ++i) {
+            if (fixedTimeStep && interpolation && i == pendingSteps - 1) {
+                StorePreviousTransforms();
+            }
+            world->Step(pendingStepSize, solverLevel.velocityIterations, solverLevel.positionIterations);
+            GatherActiveBodies();
+
+            if (stateHashing || recorder) {
+                stateHash = HashWorldState(*world);
+                if (recorder) {
+                    recorder->WriteStep(pendingStepSize, 
+                        solverLevel.velocityIterations, solverLevel.positionIterations, stateHash);
+                }
+            }
+
+            stepStats.solver = solverLevel;
+            if (solverController) {
+                // Box2D measures the time of each step, regardless of profiling.
+                const double stepTime = world->GetProfile().step;
+                if (solverController->Update(stepTime, world->GetContactCount(), GetBestSolverLevel())) {
+                    ApplySolverLevel();
+                }
+            }
+
+            if (profiler) {
+                const b2Profile& profile = world->GetProfile();
+                stepStats.collideTime += profile.collide;
+                stepStats.solveTime += profile.solve;
+                stepStats.broadphaseTime += profile.broadphase;
+                stepStats.solveTOITime += profile.solveTOI;
+            }
+        }
+
+        stepStats.bodyCount = world->GetBodyCount();
+        stepStats.contactCount = world->GetContactCount();
+        stepStats.numSteps = pendingSteps;
+
+        if (profiler) {
+            stepStats.stepTime = profiler->EndPhase("Step", start);
+        }
+    }
+
+    void Box2DPhysicsSystem::EndUpdate()
+    {
+        Profiler::Clock::time_point start;
+        if (profiler) {
+            start = Profiler::Clock::now();
+        }
+
+        DeployTransforms(fixedTimeStep && interpolation ? accumulator / stepSize : 1.0f);
+
+        if (profiler) {
+            stepStats.deployTime = profiler->EndPhase("Deploy", start);
+            start = Profiler::Clock::now();
+        }
+
+        UpdateSensors();
+        reportedSensorEvents = sensorEvents.size();
+        DispatchCollisionSignals();
+
+        stepStats.awakeBodyCount = bindings->active.size();
+        stepStats.dormantBodyCount = numDormant;
+        stepStats.contactEventCount = contactEvents.size();
+        stepStats.impactEventCount = impacts.size();
+
+        if (profiler) {
+            stepStats.dispatchTime = profiler->EndPhase("Dispatch", start);
+            stepStats.updateTime = stepStats.spawnTime + stepStats.collectTime 
+                + stepStats.stepTime + stepStats.deployTime + stepStats.dispatchTime;
+            profiler->AddSample(stepStats);
+        }
     }
     
     void Box2DPhysicsSystem::CollectTransforms()
     {
-        for (auto & entity : GetEntityView()) {
-            
-            auto& body = entity->GetComponent<CBox2DBody>();
-            // We must process dynamic bodies as well, some game logic
-            // does rely on this.
-            if (body.GetType() != CBody::Type::Static) {
-                const auto& tx = entity->GetComponent<CPose>().transform;
-                body.boxBody->SetTransform(
-                    b2Vec2(tx.GetTranslationX(), tx.GetTranslationY()), 
-                    tx.GetRotation()
-                );
+        if (IsParallelSync()) {
+            // Setting transforms modifies the broad-phase, hence only the
+            // search for changed poses runs in parallel.
+            ForEachSyncChunk([this](size_t begin, size_t end, vector<int>& out) {
+                for (size_t i = begin; i < end; ++i) {
+                    if (IsPoseChanged(i)) {
+                        out.push_back(static_cast<int>(i));
+                    }
+                }
+            });
+
+            for (const auto& chunk : syncChunks) {
+                for (int idx : chunk.indices) {
+                    PushPose(idx);
+                }
+            }
+            return;
+        }
+
+        const size_t n = bindings->Size();
+        for (size_t i = 0; i < n; ++i) {
+            if (IsPoseChanged(i)) {
+                PushPose(i);
+            }
+        }
+    }
+
+    bool Box2DPhysicsSystem::IsPoseChanged(size_t idx) const
+    {
+        const auto& table = *bindings;
+        if (table.types[idx] == CBody::Type::Static) {
+            return false;
+        }
+
+        // Only poses changed outside this system need to be pushed.
+        // Some game logic relies on pushing all poses, however,
+        // interpolated poses we have written ourselves must never
+        // be pushed back.
+        const auto& tx = table.poses[idx]->transform;
+        const auto& synced = table.synced[idx];
+        return tx.GetTranslationX() != synced.x
+            || tx.GetTranslationY() != synced.y
+            || tx.GetRotation() != synced.angle
+            || (alwaysPushPoses && !(table.flags[idx] & BindingTable::Interpolated));
+    }
+
+    void Box2DPhysicsSystem::PushPose(size_t idx)
+    {
+        auto& table = *bindings;
+        const auto& tx = table.poses[idx]->transform;
+        auto& synced = table.synced[idx];
+        synced.x = tx.GetTranslationX();
+        synced.y = tx.GetTranslationY();
+        synced.angle = tx.GetRotation();
+        table.bodies[idx]->SetTransform(b2Vec2(synced.x, synced.y), synced.angle);
+        if (recorder) {
+            recorder->WriteTeleport(*table.bodies[idx], synced.x, synced.y, synced.angle);
+        }
+
+        // Do not interpolate from the position before teleporting.
+        table.previous[idx] = synced;
+        table.flags[idx] &= ~BindingTable::Interpolated;
+
+        // Teleported bodies might have entered or left a region, see UpdateDormancy.
+        table.Activate(idx);
+    }
+
+    bool Box2DPhysicsSystem::IsParallelSync() const
+    {
+        return workerPool && bindings->Size() >= parallelSyncThreshold;
+    }
+
+    void Box2DPhysicsSystem::ForEachSyncChunk(
+        const function<void(size_t begin, size_t end, vector<int>& out)>& func)
+    {
+        const size_t n = bindings->Size();
+        const size_t grain = parallelSyncGrain;
+        const size_t numChunks = (n + grain - 1) / grain;
+        if (syncChunks.size() < numChunks) {
+            syncChunks.resize(numChunks);
+        }
+
+        // Chunks start at multiples of the grain, which identifies the
+        // list of each chunk regardless of the thread processing it.
+        workerPool->ParallelFor(n, grain, [this, &func, grain](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i += grain) {
+                auto& out = syncChunks[i / grain].indices;
+                out.clear();
+                func(i, min(i + grain, end), out);
+            }
+        });
+
+        for (size_t i = numChunks; i < syncChunks.size(); ++i) {
+            syncChunks[i].indices.clear();
+        }
+    }
+
+    void Box2DPhysicsSystem::ActivateBody(CBox2DBody& body)
+    {
+        assert(body.bindingIndex >= 0);
+        bindings->Activate(body.bindingIndex);
+    }
+
+    void Box2DPhysicsSystem::UpdateBodyType(CBox2DBody& body)
+    {
+        assert(body.bindingIndex >= 0);
+        bindings->types[body.bindingIndex] = body.GetType();
+        bindings->Activate(body.bindingIndex);
+    }
+
+    void Box2DPhysicsSystem::GatherActiveBodies()
+    {
+        // Box2D wakes up bodies touching awake bodies without notice, hence
+        // we follow touching contacts starting at the active bodies. The
+        // list grows while we iterate over it.
+        auto& table = *bindings;
+        for (size_t i = 0; i < table.active.size(); ++i) {
+            auto body = table.bodies[table.active[i]];
+            for (auto ce = body->GetContactList(); ce; ce = ce->next) {
+                if (ce->contact->IsTouching()) {
+                    auto other = reinterpret_cast<CBox2DBody*>(
+                        ce->other->GetUserData().pointer);
+                    table.Activate(other->bindingIndex);
+                }
             }
+        }
+    }
 
+    void Box2DPhysicsSystem::StorePreviousTransforms()
+    {
+        auto& table = *bindings;
+        for (int idx : table.active) {
+            const b2Body* body = table.bodies[idx];
+            const b2Vec2& p = body->GetPosition();
+            table.previous[idx] = {p.x, p.y, body->GetAngle()};
         }
     }
 
-    void Box2DPhysicsSystem::DeployTransforms()
+    void Box2DPhysicsSystem::DeployTransforms(float alpha)
     {
-        for (auto & entity : GetEntityView()) {
+        auto& table = *bindings;
+        if (IsParallelSync()) {
+            // Chunks of consecutive bindings instead of the active list keep
+            // threads from writing to the same cache lines of the binding
+            // table, except at chunk boundaries. The poses of the entities
+            // are allocated elsewhere and might still share cache lines
+            // across chunks. Deactivating reorders the active list, hence
+            // it takes place afterwards.
+            ForEachSyncChunk([this, alpha](size_t begin, size_t end, vector<int>& out) {
+                const auto& slots = bindings->activeSlots;
+                for (size_t i = begin; i < end; ++i) {
+                    if (slots[i] >= 0 && !DeployTransform(i, alpha)) {
+                        out.push_back(static_cast<int>(i));
+                    }
+                }
+            });
+
+            for (const auto& chunk : syncChunks) {
+                for (int idx : chunk.indices) {
+                    SettleBody(idx);
+                }
+            }
+            return;
+        }
 
-            auto& body = entity->GetComponent<CBox2DBody>();
-            if (body.GetType() == CBody::Type::Dynamic) {
-                auto& pose = entity->GetComponent<CPose>();
-                const b2Vec2& p = body.boxBody->GetPosition();
-                pose.transform.SetTranslation(p.x, p.y);
-                pose.transform.SetRotation(body.boxBody->GetAngle());
+        size_t i = 0;
+        while (i < table.active.size()) {
+            const int idx = table.active[i];
+            if (DeployTransform(idx, alpha)) {
+                ++i;
+            } else {
+                SettleBody(idx);
             }
         }
     }
 
+    bool Box2DPhysicsSystem::DeployTransform(size_t idx, float alpha)
+    {
+        auto& table = *bindings;
+        const b2Body* body = table.bodies[idx];
+        const b2Vec2& p = body->GetPosition();
+        const float angle = body->GetAngle();
+        const auto type = table.types[idx];
+
+        if (type == CBody::Type::Dynamic 
+            || (type == CBody::Type::Kinematic && !alwaysPushPoses)) 
+        {
+            auto& synced = table.synced[idx];
+            if (alpha < 1.0f) {
+                const float beta = 1.0f - alpha;
+                const auto& prev = table.previous[idx];
+                synced.x = prev.x * beta + p.x * alpha;
+                synced.y = prev.y * beta + p.y * alpha;
+                synced.angle = prev.angle * beta + angle * alpha;
+                table.flags[idx] |= BindingTable::Interpolated;
+            } else {
+                synced = {p.x, p.y, angle};
+                table.flags[idx] &= ~BindingTable::Interpolated;
+            }
+
+            auto& tx = table.poses[idx]->transform;
+            tx.SetTranslation(synced.x, synced.y);
+            tx.SetRotation(synced.angle);
+        }
+
+        if (asyncStep) {
+            // Body state must not be read from Box2D while stepping.
+            auto& comp = *table.components[idx];
+            const b2Vec2& v = body->GetLinearVelocity();
+            comp.CBody::SetLinearVelocity(v.x, v.y);
+            comp.CBody::SetAngularVelocity(body->GetAngularVelocity());
+            comp.awake = body->IsAwake();
+        }
+
+        if (body->IsAwake() && type != CBody::Type::Static) {
+            return true;
+        }
+
+        // Sleeping bodies do not move, interpolation must start at
+        // their resting position once they are woken up.
+        table.previous[idx] = {p.x, p.y, angle};
+        return false;
+    }
+
     void Box2DPhysicsSystem::OnEntityAdded(shared_ptr<Entity> entity)
     {
-        auto& pose = entity->GetComponent<CPose>();
         auto& body = entity->GetComponent<CBox2DBody>();
+        if (body.boxBody) {
+            // Re-added before its deferred removal took place.
+            WaitForStep();
+            FlushDespawns();
+        }
 
-		b2BodyDef bodyDef;
+        if (deferredSpawning || IsStepping()) {
+            pendingSpawns.push_back(entity.get());
+            return;
+        }
 
-		switch (body.GetType()) {
-		case CBody::Type::Static:
-			bodyDef.type = b2_staticBody;
-			break;
-		case CBody::Type::Kinematic:
-			bodyDef.type = b2_kinematicBody;
-			break;
-		case CBody::Type::Dynamic:
-			bodyDef.type = b2_dynamicBody;
-			break;
-		}
+        SpawnBody(*entity);
+    }
 
+    void Box2DPhysicsSystem::OnEntityRemoved(shared_ptr<Entity> entity)
+    {
+        auto& body = entity->GetComponent<CBox2DBody>();
+        if (!body.boxBody) {
+            // Removed before its deferred creation took place, or its body
+            // has been dropped by clearing the world.
+            auto it = find(pendingSpawns.rbegin(), pendingSpawns.rend(), entity.get());
+            if (it != pendingSpawns.rend()) {
+                *it = pendingSpawns.back();
+                pendingSpawns.pop_back();
+            }
+            return;
+        }
+
+        if (deferredSpawning || IsStepping()) {
+            // Keep the entity alive, the binding refers to its components.
+            pendingDespawns.push_back(entity);
+            return;
+        }
+
+        DespawnBody(body);
+    }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::SetDeferredSpawning(bool b)
+    {
+        deferredSpawning = b;
+        if (!b && world) {
+            WaitForStep();
+            FlushDespawns();
+            FlushSpawns();
+        }
+        return *this;
+    }
+
+    Box2DPhysicsSystem& Box2DPhysicsSystem::ReserveBodies(size_t n)
+    {
+        WaitForStep();
+        bindings->Reserve(n);
+        pendingSpawns.reserve(n);
+        return *this;
+    }
+
+    void Box2DPhysicsSystem::FlushSpawns()
+    {
+        if (pendingSpawns.empty()) {
+            return;
+        }
+
+        bindings->Reserve(bindings->Size() + pendingSpawns.size());
+        for (auto entity : pendingSpawns) {
+            SpawnBody(*entity);
+        }
+        pendingSpawns.clear();
+    }
+
+    void Box2DPhysicsSystem::FlushDespawns()
+    {
+        for (auto& entity : pendingDespawns) {
+            DespawnBody(entity->GetComponent<CBox2DBody>());
+        }
+        pendingDespawns.clear();
+    }
+
+    void Box2DPhysicsSystem::SpawnBody(Entity& entity)
+    {
+        auto& pose = entity.GetComponent<CPose>();
+        auto& body = entity.GetComponent<CBox2DBody>();
+
+        b2BodyDef bodyDef;
+        bodyDef.type = ToBox2DType(body.GetType());
         bodyDef.position.Set(pose.transform.GetTranslationX(), pose.transform.GetTranslationY());
         bodyDef.angle = pose.transform.GetRotation();
         bodyDef.linearDamping = body.GetLinearDamping();
@@ -209,7 +1348,13 @@ namespace astu::suite2d {
         bodyDef.linearVelocity.Set(body.GetLinearVelocity().x, body.GetLinearVelocity().y);
         bodyDef.angularVelocity = body.GetAngularVelocity();
         bodyDef.fixedRotation = false;
+        bodyDef.allowSleep = body.IsSleepingAllowed();
+        bodyDef.awake = body.awake;
+        bodyDef.enabled = body.IsEnabled();
+        bodyDef.userData.pointer = reinterpret_cast<uintptr_t>(&body);
         body.boxBody = world->CreateBody(&bodyDef);
+        body.system = this;
+        bindings->Add(entity, body, body.boxBody, pose);
 
         // b2MassData massData;
         // body.boxBody->GetMassData(&massData);
@@ -218,25 +1363,63 @@ namespace astu::suite2d {
         // }
         // body.boxBody->SetMassData(&massData);
 
-        AddFixture(*entity, *body.boxBody);
+        try {
+            AddFixture(entity, *body.boxBody);
+        } catch (...) {
+            // Invalid colliders leave no partially created body behind.
+            if (entity.HasComponent<CBodyCollider>()) {
+                if (auto boxCol = ToBox2DCollider(entity.GetComponent<CBodyCollider>())) {
+                    boxCol->ReleaseFixtures();
+                }
+            }
+            world->DestroyBody(body.boxBody);
+            bindings->Remove(body.bindingIndex);
+            body.boxBody = nullptr;
+            body.system = nullptr;
+            throw;
+        }
+        ActivateBody(body);
+
+        if (recorder) {
+            recorder->WriteSpawn(*body.boxBody);
+        }
     }
 
-    void Box2DPhysicsSystem::OnEntityRemoved(shared_ptr<Entity> entity)
+    void Box2DPhysicsSystem::DespawnBody(CBox2DBody& body)
     {
-        // Destroy the Box2D body.
-        auto& body = entity->GetComponent<CBox2DBody>();
         assert(body.boxBody);
+        if (recorder) {
+            recorder->WriteDespawn(*body.boxBody);
+        }
+
+        // Destroying the body might end contacts and thereby activate the
+        // binding, hence the binding must be removed afterwards.
         world->DestroyBody(body.boxBody);
+        if (IsDormant(body)) {
+            --numDormant;
+        }
+
+        // Pending changes refer to the destroyed body and fixtures.
+        body.DiscardPendingChanges();
+        auto& entity = *bindings->entities[body.bindingIndex];
+        if (entity.HasComponent<CBodyCollider>()) {
+            IBox2DCollider* boxCol = ToBox2DCollider(entity.GetComponent<CBodyCollider>());
+            if (boxCol) {
+                boxCol->ReleaseFixtures();
+            }
+        }
+        bindings->Remove(body.bindingIndex);
         body.boxBody = nullptr;
+        body.system = nullptr;
     }
 
     void Box2DPhysicsSystem::AddFixture(Entity& entity, b2Body& body)
     {
         if (entity.HasComponent<CBodyCollider>()) {
-            auto& col = entity.GetComponent<CBodyCollider>();    
-            IBox2DCollider* boxCol = dynamic_cast<IBox2DCollider*>(&col);
+            IBox2DCollider* boxCol = ToBox2DCollider(entity.GetComponent<CBodyCollider>());
             if (boxCol) {
-                boxCol->CreateFixture(body);        
+                boxCol->CreateFixture(body, *shapeCache);
+                boxCol->SetSystem(this);
             }
         }
     }
@@ -0,0 +1,440 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "Box2DReplay.h"
+#include "StepRecorder.h"
+#include "WorldReservation.h"
+
+// Box2D includes
+#include <box2d/box2d.h>
+
+// C++ Standard Library includes
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace std;
+
+namespace astu::suite2d {
+
+    /**
+     * Reads the records of a recording.
+     */
+    class RecordReader {
+    public:
+
+        RecordReader(const vector<uint8_t>& data) : data(data), pos(0) {}
+
+        bool AtEnd() const {
+            return pos >= data.size();
+        }
+
+        template <typename T>
+        T Get() {
+            if (data.size() - pos < sizeof(T)) {
+                throw std::runtime_error("Recording is truncated");
+            }
+            T value;
+            memcpy(&value, data.data() + pos, sizeof(T));
+            pos += sizeof(T);
+            return value;
+        }
+
+    private:
+        /** The content of the recording. */
+        const vector<uint8_t>& data;
+
+        /** The current read position. */
+        size_t pos;
+    };
+
+    /**
+     * Creates a fixture as recorded by `StepRecorder::PutFixture`.
+     */
+    static void ReadFixture(RecordReader& in, b2Body& body)
+    {
+        b2FixtureDef def;
+        def.density = in.Get<float>();
+        def.friction = in.Get<float>();
+        def.restitution = in.Get<float>();
+        def.restitutionThreshold = in.Get<float>();
+        def.filter.categoryBits = in.Get<uint16>();
+        def.filter.maskBits = in.Get<uint16>();
+        def.filter.groupIndex = in.Get<int16>();
+        def.isSensor = in.Get<uint8_t>() != 0;
+
+        auto type = static_cast<b2Shape::Type>(in.Get<uint8_t>());
+        float radius = in.Get<float>();
+        switch (type) {
+        case b2Shape::e_circle: {
+            b2CircleShape circle;
+            circle.m_radius = radius;
+            circle.m_p = in.Get<b2Vec2>();
+            def.shape = &circle;
+            body.CreateFixture(&def);
+            break;
+        }
+
+        case b2Shape::e_edge: {
+            b2EdgeShape edge;
+            edge.m_radius = radius;
+            edge.m_vertex0 = in.Get<b2Vec2>();
+            edge.m_vertex1 = in.Get<b2Vec2>();
+            edge.m_vertex2 = in.Get<b2Vec2>();
+            edge.m_vertex3 = in.Get<b2Vec2>();
+            edge.m_oneSided = in.Get<uint8_t>() != 0;
+            def.shape = &edge;
+            body.CreateFixture(&def);
+            break;
+        }
+
+        case b2Shape::e_polygon: {
+            b2PolygonShape polygon;
+            polygon.m_radius = radius;
+            polygon.m_centroid = in.Get<b2Vec2>();
+            polygon.m_count = in.Get<int32>();
+            if (polygon.m_count < 3 || polygon.m_count > b2_maxPolygonVertices) {
+                throw std::runtime_error("Recording contains invalid polygon");
+            }
+            for (int32 i = 0; i < polygon.m_count; ++i) {
+                polygon.m_vertices[i] = in.Get<b2Vec2>();
+                polygon.m_normals[i] = in.Get<b2Vec2>();
+            }
+            def.shape = &polygon;
+            body.CreateFixture(&def);
+            break;
+        }
+
+        case b2Shape::e_chain: {
+            int32 count = in.Get<int32>();
+            if (count < 2) {
+                throw std::runtime_error("Recording contains invalid chain");
+            }
+            vector<b2Vec2> vertices(count);
+            for (auto& v : vertices) {
+                v = in.Get<b2Vec2>();
+            }
+            b2Vec2 prev = in.Get<b2Vec2>();
+            b2Vec2 next = in.Get<b2Vec2>();
+
+            // Loops are stored with their closing vertex, which yields
+            // the same edges when created as open chain.
+            b2ChainShape chain;
+            chain.CreateChain(vertices.data(), count, prev, next);
+            chain.m_radius = radius;
+            def.shape = &chain;
+            body.CreateFixture(&def);
+            break;
+        }
+
+        default:
+            throw std::runtime_error("Recording contains unknown shape type");
+        }
+    }
+
+    /**
+     * Creates a body as recorded by `StepRecorder::WriteSpawn`.
+     */
+    static b2Body* ReadBody(RecordReader& in, b2World& world)
+    {
+        b2BodyDef def;
+        def.type = static_cast<b2BodyType>(in.Get<uint8_t>());
+        def.position.x = in.Get<float>();
+        def.position.y = in.Get<float>();
+        def.angle = in.Get<float>();
+        def.linearVelocity.x = in.Get<float>();
+        def.linearVelocity.y = in.Get<float>();
+        def.angularVelocity = in.Get<float>();
+        def.linearDamping = in.Get<float>();
+        def.angularDamping = in.Get<float>();
+        def.gravityScale = in.Get<float>();
+        auto flags = in.Get<uint8_t>();
+        def.fixedRotation = (flags & 0x01) != 0;
+        def.bullet = (flags & 0x02) != 0;
+        def.awake = (flags & 0x04) != 0;
+        def.allowSleep = (flags & 0x08) != 0;
+        def.enabled = (flags & 0x10) != 0;
+
+        b2Body* body = world.CreateBody(&def);
+        auto numFixtures = in.Get<uint16_t>();
+        for (uint16_t i = 0; i < numFixtures; ++i) {
+            ReadFixture(in, *body);
+        }
+        return body;
+    }
+
+    /**
+     * Reads a capacity as recorded by `StepRecorder::PutCapacity`.
+     */
+    static WorldCapacity ReadCapacity(RecordReader& in)
+    {
+        WorldCapacity capacity;
+        capacity.bodies = static_cast<size_t>(in.Get<uint64_t>());
+        capacity.fixtures = static_cast<size_t>(in.Get<uint64_t>());
+        capacity.contacts = static_cast<size_t>(in.Get<uint64_t>());
+        return capacity;
+    }
+
+    /**
+     * Returns a fixture of a body by its index within the fixture list.
+     */
+    static b2Fixture& GetFixture(b2Body& body, uint16_t idx)
+    {
+        b2Fixture* fixture = body.GetFixtureList();
+        for (uint16_t i = 0; i < idx && fixture; ++i) {
+            fixture = fixture->GetNext();
+        }
+        if (!fixture) {
+            throw std::runtime_error("Recording refers to unknown fixture");
+        }
+        return *fixture;
+    }
+
+    /**
+     * Changes a fixture as recorded by `StepRecorder::WriteFixture`.
+     */
+    static void ReadFixtureChanges(RecordReader& in, b2Fixture& fixture)
+    {
+        auto changes = in.Get<uint8_t>();
+        float density = in.Get<float>();
+        float friction = in.Get<float>();
+        float restitution = in.Get<float>();
+        auto categoryBits = in.Get<uint16>();
+        auto maskBits = in.Get<uint16>();
+        bool sensor = in.Get<uint8_t>() != 0;
+
+        // Same order as the fixtures have been changed while recording.
+        if (changes & FixtureRestitution) {
+            fixture.SetRestitution(restitution);
+        }
+        if (changes & FixtureFriction) {
+            fixture.SetFriction(friction);
+        }
+        if (changes & FixtureDensity) {
+            fixture.SetDensity(density);
+        }
+        if (changes & FixtureFilter) {
+            auto filter = fixture.GetFilterData();
+            filter.categoryBits = categoryBits;
+            filter.maskBits = maskBits;
+            fixture.SetFilterData(filter);
+        }
+        if (changes & FixtureSensor) {
+            fixture.SetSensor(sensor);
+        }
+    }
+
+    /**
+     * Sets the impulses of a contact as recorded by
+     * `StepRecorder::WriteContactImpulses`.
+     */
+    static void ReadContactImpulses(RecordReader& in, b2Body& bodyA, b2Body& bodyB)
+    {
+        auto fixtureA = &GetFixture(bodyA, in.Get<uint16_t>());
+        auto fixtureB = &GetFixture(bodyB, in.Get<uint16_t>());
+        auto childA = in.Get<int32>();
+        auto childB = in.Get<int32>();
+        auto pointCount = in.Get<uint8_t>();
+        if (pointCount > b2_maxManifoldPoints) {
+            throw std::runtime_error("Recording contains invalid contact");
+        }
+
+        b2ManifoldPoint points[b2_maxManifoldPoints];
+        for (uint8_t i = 0; i < pointCount; ++i) {
+            points[i].id.key = in.Get<uint32>();
+            points[i].normalImpulse = in.Get<float>();
+            points[i].tangentImpulse = in.Get<float>();
+        }
+
+        for (auto ce = bodyA.GetContactList(); ce; ce = ce->next) {
+            b2Contact& contact = *ce->contact;
+            if (contact.GetFixtureA() != fixtureA || contact.GetFixtureB() != fixtureB
+                || contact.GetChildIndexA() != childA || contact.GetChildIndexB() != childB)
+            {
+                continue;
+            }
+
+            b2Manifold& manifold = *contact.GetManifold();
+            if (manifold.pointCount != pointCount) {
+                throw std::runtime_error("Recording does not match contact");
+            }
+            for (uint8_t i = 0; i < pointCount; ++i) {
+                manifold.points[i].normalImpulse = points[i].normalImpulse;
+                manifold.points[i].tangentImpulse = points[i].tangentImpulse;
+            }
+            return;
+        }
+        throw std::runtime_error("Recording refers to unknown contact");
+    }
+
+    Box2DReplayer::Box2DReplayer(const string& filename)
+    {
+        ifstream file(filename, ios::in | ios::binary);
+        if (!file) {
+            throw std::runtime_error("Unable to open recording file '" + filename + "'");
+        }
+        data.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    }
+
+    ReplayResult Box2DReplayer::Run(bool stopOnDivergence) const
+    {
+        RecordReader in(data);
+        if (in.Get<uint32_t>() != RECORDING_MAGIC) {
+            throw std::runtime_error("Not a Box2D recording");
+        }
+        if (in.Get<uint16_t>() != RECORDING_VERSION) {
+            throw std::runtime_error("Unsupported version of Box2D recording");
+        }
+
+        unique_ptr<b2World> world = make_unique<b2World>(b2Vec2(0, 0));
+        unordered_map<uint64_t, b2Body*> bodies;
+        ReplayResult result;
+
+        auto getBody = [&bodies](uint64_t id) {
+            auto it = bodies.find(id);
+            if (it == bodies.end()) {
+                throw std::runtime_error("Recording refers to unknown body");
+            }
+            return it->second;
+        };
+
+        while (!in.AtEnd()) {
+            auto tag = in.Get<RecordTag>();
+            if (tag == RecordTag::CreateWorld) {
+                // The bodies of the old world are dropped together with it.
+                bodies.clear();
+                world = nullptr;
+                world = make_unique<b2World>(in.Get<b2Vec2>());
+                world->SetAllowSleeping(in.Get<uint8_t>() != 0);
+                world->SetContinuousPhysics(in.Get<uint8_t>() != 0);
+                ReserveWorldMemory(*world, ReadCapacity(in));
+                continue;
+            }
+
+            if (tag == RecordTag::Reserve) {
+                ReserveWorldMemory(*world, ReadCapacity(in));
+                continue;
+            }
+
+            if (tag == RecordTag::SetGravity) {
+                world->SetGravity(in.Get<b2Vec2>());
+                continue;
+            }
+
+            if (tag == RecordTag::AllowSleeping) {
+                world->SetAllowSleeping(in.Get<uint8_t>() != 0);
+                continue;
+            }
+
+            if (tag == RecordTag::ContinuousPhysics) {
+                world->SetContinuousPhysics(in.Get<uint8_t>() != 0);
+                continue;
+            }
+
+            if (tag == RecordTag::Step) {
+                float dt = in.Get<float>();
+                int32 velocityIterations = in.Get<int32>();
+                int32 positionIterations = in.Get<int32>();
+                uint64_t recorded = in.Get<uint64_t>();
+
+                world->Step(dt, velocityIterations, positionIterations);
+                uint64_t replayed = HashWorldState(*world);
+                if (replayed != recorded && !result.diverged) {
+                    result.diverged = true;
+                    result.divergingStep = result.numSteps;
+                    result.recordedHash = recorded;
+                    result.replayedHash = replayed;
+                }
+                ++result.numSteps;
+                if (result.diverged && stopOnDivergence) {
+                    break;
+                }
+                continue;
+            }
+
+            auto id = in.Get<uint64_t>();
+            if (tag == RecordTag::Spawn) {
+                // Addresses are reused after bodies have been destroyed.
+                bodies[id] = ReadBody(in, *world);
+                continue;
+            }
+
+            b2Body* body = getBody(id);
+            switch (tag) {
+            case RecordTag::Despawn:
+                world->DestroyBody(body);
+                bodies.erase(id);
+                break;
+
+            case RecordTag::SetFixture: {
+                b2Fixture& fixture = GetFixture(*body, in.Get<uint16_t>());
+                ReadFixtureChanges(in, fixture);
+                break;
+            }
+
+            case RecordTag::ContactImpulses:
+                ReadContactImpulses(in, *body, *getBody(in.Get<uint64_t>()));
+                break;
+
+            case RecordTag::Teleport: {
+                float x = in.Get<float>();
+                float y = in.Get<float>();
+                float angle = in.Get<float>();
+                body->SetTransform(b2Vec2(x, y), angle);
+                break;
+            }
+
+            default: {
+                float x = in.Get<float>();
+                float y = in.Get<float>();
+                switch (tag) {
+                case RecordTag::SetLinearVelocity:
+                    body->SetLinearVelocity(b2Vec2(x, y));
+                    break;
+                case RecordTag::SetAngularVelocity:
+                    body->SetAngularVelocity(x);
+                    break;
+                case RecordTag::SetLinearDamping:
+                    body->SetLinearDamping(x);
+                    break;
+                case RecordTag::SetAngularDamping:
+                    body->SetAngularDamping(x);
+                    break;
+                case RecordTag::ApplyTorque:
+                    body->ApplyTorque(x, true);
+                    break;
+                case RecordTag::ApplyForce:
+                    body->ApplyForceToCenter(b2Vec2(x, y), true);
+                    break;
+                case RecordTag::SetType:
+                    body->SetType(static_cast<b2BodyType>(static_cast<int>(x)));
+                    break;
+                case RecordTag::SetAwake:
+                    body->SetAwake(x != 0);
+                    break;
+                case RecordTag::SetEnabled:
+                    body->SetEnabled(x != 0);
+                    break;
+                case RecordTag::SetSleepingAllowed:
+                    body->SetSleepingAllowed(x != 0);
+                    break;
+                default:
+                    throw std::runtime_error("Recording contains unknown record");
+                }
+                break;
+            }
+            }
+        }
+
+        return result;
+    }
+
+} // end of namespace
@@ -0,0 +1,137 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "Box2DWorldGroup.h"
+#include "Box2DPhysicsSystem.h"
+#include "Box2DGlobals.h"
+#include "WorkerPool.h"
+
+// Box2D includes
+#include <box2d/box2d.h>
+
+// C++ Standard Library includes
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+using namespace std;
+
+namespace astu::suite2d {
+
+    /**
+     * Estimates the cost of stepping a world.
+     *
+     * @param world the Box2D world
+     * @return the estimated cost
+     */
+    static inline size_t EstimateCost(const b2World& world)
+    {
+        return static_cast<size_t>(world.GetBodyCount()) + world.GetContactCount();
+    }
+
+    Box2DWorldGroup::Box2DWorldGroup(int updatePriority)
+        : BaseService("Box2D World Group")
+        , Updatable(updatePriority)
+        , workerThreads(0)
+        , stepTime(0)
+    {
+        // Intentionally left empty.
+    }
+
+    Box2DWorldGroup::~Box2DWorldGroup()
+    {
+        for (auto& system : worlds) {
+            system->group = nullptr;
+        }
+    }
+
+    Box2DWorldGroup& Box2DWorldGroup::SetWorkerThreads(unsigned int n)
+    {
+        workerThreads = n;
+        if (IsStarted()) {
+            workerPool = n > 0 ? make_unique<WorkerPool>(n) : nullptr;
+        }
+        return *this;
+    }
+
+    void Box2DWorldGroup::AddWorld(shared_ptr<Box2DPhysicsSystem> system)
+    {
+        if (system->group) {
+            throw std::logic_error("Physics system already belongs to a world group");
+        }
+        if (system->IsAsyncStep()) {
+            throw std::logic_error("Asynchronous physics systems cannot be added to a world group");
+        }
+        system->group = this;
+        worlds.push_back(system);
+    }
+
+    void Box2DWorldGroup::RemoveWorld(shared_ptr<Box2DPhysicsSystem> system)
+    {
+        auto it = find(worlds.begin(), worlds.end(), system);
+        if (it != worlds.end()) {
+            system->group = nullptr;
+            worlds.erase(it);
+        }
+    }
+
+    void Box2DWorldGroup::OnStartup()
+    {
+        if (workerThreads > 0) {
+            workerPool = make_unique<WorkerPool>(workerThreads);
+        }
+        stepTime = 0;
+    }
+
+    void Box2DWorldGroup::OnShutdown()
+    {
+        workerPool = nullptr;
+        schedule.clear();
+    }
+
+    void Box2DWorldGroup::OnUpdate()
+    {
+        schedule.clear();
+        for (auto& system : worlds) {
+            if (system->world) {
+                system->BeginUpdate();
+                schedule.push_back(system.get());
+            }
+        }
+
+        // Largest worlds first, threads finishing early take the small ones.
+        sort(schedule.begin(), schedule.end(), 
+            [](const Box2DPhysicsSystem* a, const Box2DPhysicsSystem* b) {
+                return EstimateCost(*a->world) > EstimateCost(*b->world);
+            });
+
+        auto start = chrono::steady_clock::now();
+        if (workerPool) {
+            // Worlds share the global state of Box2D, see PrepareConcurrentSteps.
+            PrepareConcurrentSteps();
+            workerPool->ParallelFor(schedule.size(), 1, [this](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    schedule[i]->Simulate();
+                }
+            });
+        } else {
+            for (auto system : schedule) {
+                system->Simulate();
+            }
+        }
+        stepTime = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        // Join point, all worlds have been stepped.
+        for (auto& system : worlds) {
+            if (system->world) {
+                system->EndUpdate();
+            }
+        }
+    }
+
+} // end of namespace
@@ -8,6 +8,9 @@
 // Local includes
 #include <Suite2D/CPose.h>
 #include "CBox2DBody.h"
+#include "Box2DPhysicsSystem.h"
+#include "StepRecorder.h"
+#include "CommandQueue.h"
 
 // Box2D includes
 #include <box2d/box2d.h>
@@ -19,28 +22,14 @@ namespace astu::suite2d {
     void CBox2DBody::SetType(CBody::Type bodyType)
     {
         CBody::SetType(bodyType);
-
-        if (boxBody) {
-            switch(bodyType) {
-                
-            case CBody::Type::Static:
-                boxBody->SetType(b2BodyType::b2_staticBody);
-                break;
-
-            case CBody::Type::Kinematic:
-                boxBody->SetType(b2BodyType::b2_kinematicBody);
-                break;
-
-            case CBody::Type::Dynamic:
-                boxBody->SetType(b2BodyType::b2_dynamicBody);
-                break;
-            }
+        if (boxBody && !Defer(ChangedType)) {
+            Push(ChangedType);
         }
     }
 
     Vector2f CBox2DBody::GetLinearVelocity() const
     {
-        if (boxBody) {
+        if (boxBody && !IsLocked()) {
             const b2Vec2& v = boxBody->GetLinearVelocity();
             return Vector2f(v.x, v.y);
         }
@@ -50,15 +39,15 @@ namespace astu::suite2d {
     CBody& CBox2DBody::SetLinearVelocity(float vx, float vy)
     {
         CBody::SetLinearVelocity(vx, vy);
-        if (boxBody) {
-            boxBody->SetLinearVelocity(b2Vec2(vx, vy));
+        if (boxBody && !Defer(ChangedLinearVelocity)) {
+            Push(ChangedLinearVelocity);
         }
         return *this;
     }
 
     float CBox2DBody::GetAngularVelocity() const
     {
-        if (boxBody) {
+        if (boxBody && !IsLocked()) {
             return boxBody->GetAngularVelocity();
         }
         return CBody::GetAngularVelocity();
@@ -67,8 +56,8 @@ namespace astu::suite2d {
     CBody& CBox2DBody::SetAngularVelocity(float av) 
     {
         CBody::SetAngularVelocity(av);
-        if (boxBody) {
-            boxBody->SetAngularVelocity(av);
+        if (boxBody && !Defer(ChangedAngularVelocity)) {
+            Push(ChangedAngularVelocity);
         }
 
         return *this;
@@ -78,8 +67,8 @@ namespace astu::suite2d {
     {
         CBody::SetLinearDamping(damping);
 
-        if (boxBody) {
-            boxBody->SetLinearDamping(damping);
+        if (boxBody && !Defer(ChangedLinearDamping)) {
+            Push(ChangedLinearDamping);
         }
     }
 
@@ -87,21 +76,26 @@ namespace astu::suite2d {
     {
         CBody::SetAngularDamping(damping);
 
-        if (boxBody) {
-            boxBody->SetAngularDamping(damping);
+        if (boxBody && !Defer(ChangedAngularDamping)) {
+            Push(ChangedAngularDamping);
         }
     }
 
     void CBox2DBody::ApplyTorque(float torque)
     {
-        if (boxBody) {
-            boxBody->ApplyTorque(torque, true);
+        if (!boxBody) {
+            return;
+        }
+
+        pendingTorque += torque;
+        if (!Defer(AppliedTorque)) {
+            Push(AppliedTorque);
         }
     }
 
     Vector2f CBox2DBody::GetWorldVector(float lvx, float lvy)
     {
-        if (boxBody) {
+        if (boxBody && !IsLocked()) {
             b2Vec2 wv = boxBody->GetWorldVector(b2Vec2(lvx, lvy));
             return Vector2f(wv.x, wv.y);
         } else if ( HasParent() && GetParent()->HasComponent<CPose>() ) {
@@ -117,7 +111,7 @@ namespace astu::suite2d {
 
     Vector2f CBox2DBody::GetWorldPoint(float lpx, float lpy)
     {
-        if (boxBody) {
+        if (boxBody && !IsLocked()) {
             b2Vec2 wp = boxBody->GetWorldPoint(b2Vec2(lpx, lpy));
             return Vector2f(wp.x, wp.y);
         } else if ( HasParent() && GetParent()->HasComponent<CPose>() ) {
@@ -134,7 +128,7 @@ namespace astu::suite2d {
 
     Vector2f CBox2DBody::GetLocalVector(float wvx, float wvy)
     {
-        if (boxBody) {
+        if (boxBody && !IsLocked()) {
             b2Vec2 lv = boxBody->GetLocalVector(b2Vec2(wvx, wvy));
             return Vector2f(lv.x, lv.y);
         }
@@ -144,7 +138,7 @@ namespace astu::suite2d {
 
     Vector2f CBox2DBody::GetLocalPoint(float wpx, float wpy)
     {
-        if (boxBody) {
+        if (boxBody && !IsLocked()) {
             b2Vec2 lp = boxBody->GetLocalPoint(b2Vec2(wpx, wpy));
             return Vector2f(lp.x, lp.y);
         }
@@ -154,8 +148,180 @@ namespace astu::suite2d {
 
     void CBox2DBody::ApplyForce(const Vector2f& force)
     {
-        if (boxBody) {
-            boxBody->ApplyForceToCenter(b2Vec2(force.x, force.y), true);
+        if (!boxBody) {
+            return;
+        }
+
+        pendingForce += force;
+        if (!Defer(AppliedForce)) {
+            Push(AppliedForce);
+        }
+    }
+
+    void CBox2DBody::SetAwake(bool b)
+    {
+        awake = b;
+        if (boxBody && !Defer(ChangedAwake)) {
+            Push(ChangedAwake);
+        }
+    }
+
+    bool CBox2DBody::IsAwake() const
+    {
+        if (boxBody && !IsLocked()) {
+            return boxBody->IsAwake();
+        }
+        return awake;
+    }
+
+    void CBox2DBody::SetSleepingAllowed(bool b)
+    {
+        sleepingAllowed = b;
+        if (boxBody && !Defer(ChangedSleepingAllowed)) {
+            Push(ChangedSleepingAllowed);
+        }
+    }
+
+    void CBox2DBody::SetEnabled(bool b)
+    {
+        enabled = b;
+        if (boxBody && !Defer(ChangedEnabled)) {
+            Push(ChangedEnabled);
+        }
+    }
+
+    void CBox2DBody::Activate()
+    {
+        if (system) {
+            system->ActivateBody(*this);
+        }
+    }
+
+    bool CBox2DBody::IsLocked() const
+    {
+        return system && system->IsStepping();
+    }
+
+    bool CBox2DBody::Defer(uint16_t change)
+    {
+        if (!system || !system->IsDeferringCommands()) {
+            return false;
+        }
+
+        if (!pendingChanges) {
+            // Listed once, no matter how many changes follow.
+            pendingBuffer = &system->GetCommandBuffer();
+            pendingSlot = pendingBuffer->bodies.size();
+            pendingBuffer->bodies.push_back(this);
+        }
+        pendingChanges |= change;
+        return true;
+    }
+
+    void CBox2DBody::Push(uint16_t changes)
+    {
+        if (changes & ChangedType) {
+            switch(CBody::GetType()) {
+                
+            case CBody::Type::Static:
+                boxBody->SetType(b2BodyType::b2_staticBody);
+                break;
+
+            case CBody::Type::Kinematic:
+                boxBody->SetType(b2BodyType::b2_kinematicBody);
+                break;
+
+            case CBody::Type::Dynamic:
+                boxBody->SetType(b2BodyType::b2_dynamicBody);
+                break;
+            }
+            if (system) {
+                system->UpdateBodyType(*this);
+                Record(RecordTag::SetType, static_cast<float>(boxBody->GetType()));
+            }
+        }
+
+        // Dormant bodies get enabled once they are inside an interest region.
+        if ((changes & ChangedEnabled) && !(enabled && system && system->IsDormant(*this) 
+            && system->GetRegionMode() == RegionMode::Disable))
+        {
+            boxBody->SetEnabled(enabled);
+            Record(RecordTag::SetEnabled, enabled ? 1.0f : 0.0f);
+        }
+
+        if (changes & ChangedSleepingAllowed) {
+            boxBody->SetSleepingAllowed(sleepingAllowed);
+            Record(RecordTag::SetSleepingAllowed, sleepingAllowed ? 1.0f : 0.0f);
+        }
+
+        if (changes & ChangedLinearDamping) {
+            boxBody->SetLinearDamping(CBody::GetLinearDamping());
+            Record(RecordTag::SetLinearDamping, CBody::GetLinearDamping());
+        }
+
+        if (changes & ChangedAngularDamping) {
+            boxBody->SetAngularDamping(CBody::GetAngularDamping());
+            Record(RecordTag::SetAngularDamping, CBody::GetAngularDamping());
+        }
+
+        if (changes & ChangedLinearVelocity) {
+            const Vector2f v = CBody::GetLinearVelocity();
+            boxBody->SetLinearVelocity(b2Vec2(v.x, v.y));
+            Record(RecordTag::SetLinearVelocity, v.x, v.y);
+        }
+
+        if (changes & ChangedAngularVelocity) {
+            boxBody->SetAngularVelocity(CBody::GetAngularVelocity());
+            Record(RecordTag::SetAngularVelocity, CBody::GetAngularVelocity());
+        }
+
+        if (changes & ChangedAwake) {
+            boxBody->SetAwake(awake);
+            Record(RecordTag::SetAwake, awake ? 1.0f : 0.0f);
+        }
+
+        if (changes & AppliedForce) {
+            boxBody->ApplyForceToCenter(b2Vec2(pendingForce.x, pendingForce.y), true);
+            Record(RecordTag::ApplyForce, pendingForce.x, pendingForce.y);
+            pendingForce.Set(0, 0);
+        }
+
+        if (changes & AppliedTorque) {
+            boxBody->ApplyTorque(pendingTorque, true);
+            Record(RecordTag::ApplyTorque, pendingTorque);
+            pendingTorque = 0;
+        }
+
+        if (changes & ~(ChangedLinearDamping | ChangedAngularDamping)) {
+            Activate();
+        }
+    }
+
+    void CBox2DBody::ApplyPendingChanges()
+    {
+        const uint16_t changes = pendingChanges;
+        pendingChanges = 0;
+        pendingBuffer = nullptr;
+        if (boxBody && changes) {
+            Push(changes);
+        }
+    }
+
+    void CBox2DBody::DiscardPendingChanges()
+    {
+        if (pendingBuffer) {
+            pendingBuffer->bodies[pendingSlot] = nullptr;
+            pendingBuffer = nullptr;
+        }
+        pendingChanges = 0;
+        pendingForce.Set(0, 0);
+        pendingTorque = 0;
+    }
+
+    void CBox2DBody::Record(RecordTag tag, float x, float y)
+    {
+        if (system && system->recorder) {
+            system->recorder->WriteCommand(tag, *boxBody, x, y);
         }
     }
 
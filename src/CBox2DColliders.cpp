@@ -7,14 +7,56 @@
 
 // Local includes
 #include "CBox2DColliders.h"
+#include "ShapeCache.h"
+#include "CommandQueue.h"
+#include "Box2DPhysicsSystem.h"
+#include "StepRecorder.h"
 
 // Box2D includes
 #include <box2d/b2_circle_shape.h>
 #include <box2d/b2_polygon_shape.h>
+#include <box2d/b2_chain_shape.h>
+#include <box2d/b2_edge_shape.h>
+
+// C++ Standard Library includes
+#include <stdexcept>
+#include <vector>
 
 namespace astu::suite2d {
 
-    void CBox2DCircleCollider::CreateFixture(b2Body & body)
+    bool ColliderChanges::Defer(IBox2DCollider& collider, uint8_t change)
+    {
+        if (!system || !system->IsDeferringCommands()) {
+            return false;
+        }
+
+        if (!flags) {
+            // Listed once, no matter how many changes follow.
+            buffer = &system->GetCommandBuffer();
+            slot = buffer->colliders.size();
+            buffer->colliders.push_back(&collider);
+        }
+        flags |= change;
+        return true;
+    }
+
+    void ColliderChanges::Record(const b2Fixture& fixture, uint8_t change) const
+    {
+        if (system && system->recorder) {
+            system->recorder->WriteFixture(fixture, change);
+        }
+    }
+
+    void ColliderChanges::Discard()
+    {
+        if (buffer) {
+            buffer->colliders[slot] = nullptr;
+            buffer = nullptr;
+        }
+        flags = 0;
+    }
+
+    void CBox2DCircleCollider::CreateFixture(b2Body & body, ShapeCache & /* cache */)
     {
         b2FixtureDef fixtureDef;
 
@@ -25,28 +67,142 @@ namespace astu::suite2d {
 
         fixtureDef.shape = &shape;
         fixture = body.CreateFixture(&fixtureDef);
+        numFixtures = 1;
     }
 
-    std::vector<b2Vec2> CBox2DPolygonCollider::tempVertices;
+    void CBox2DPolygonCollider::CreateFixture(b2Body & body, ShapeCache & cache)
+    {
+        b2FixtureDef fixtureDef;
+
+        ConfigureFixtureDef(fixtureDef);
+
+        // Concave polygons result in several convex shapes.
+        numFixtures = 0;
+        for (const auto& shape : cache.GetShapes(polygon, GetOffset().x, GetOffset().y)) {
+            fixtureDef.shape = &shape;
+            fixture = body.CreateFixture(&fixtureDef);
+            ++numFixtures;
+        }
+    }
 
-    void CBox2DPolygonCollider::CreateFixture(b2Body & body)
+    void CBox2DChainCollider::CreateFixture(b2Body & body, ShapeCache & /* cache */)
     {
+        const size_t minVertices = loop ? 3 : 2;
+        if (vertices.size() < minVertices) {
+            throw std::logic_error("Chain collider has too few vertices");
+        }
+
         b2FixtureDef fixtureDef;
 
         ConfigureFixtureDef(fixtureDef);
 
-        tempVertices.clear();
-        for (auto vtx : polygon->GetVertices()) {
-            tempVertices.push_back(
-                    b2Vec2(vtx.x + GetOffset().x, vtx.y + GetOffset().y));
+        std::vector<b2Vec2> points;
+        points.reserve(vertices.size());
+        for (auto vtx : vertices) {
+            points.push_back(b2Vec2(vtx.x + GetOffset().x, vtx.y + GetOffset().y));
+        }
+
+        // Box2D only asserts the spacing in debug builds, release builds
+        // would create degenerate edges.
+        const float minDistSqr = b2_linearSlop * b2_linearSlop;
+        const size_t numEdges = loop ? points.size() : points.size() - 1;
+        for (size_t i = 0; i < numEdges; ++i) {
+            if (b2DistanceSquared(points[i], points[(i + 1) % points.size()]) <= minDistSqr) {
+                throw std::logic_error("Chain collider has vertices closer than the linear slop");
+            }
         }
 
-        b2PolygonShape shape;
-        shape.Set(tempVertices.data(), static_cast<int32>(tempVertices.size()));
+        b2ChainShape shape;
+        const auto count = static_cast<int32>(points.size());
+        if (loop) {
+            shape.CreateLoop(points.data(), count);
+        } else {
+            // Extend the end segments to obtain ghost vertices.
+            b2Vec2 prev = points[0] + (points[0] - points[1]);
+            b2Vec2 next = points[count - 1] + (points[count - 1] - points[count - 2]);
+            shape.CreateChain(points.data(), count, prev, next);
+        }
         fixtureDef.shape = &shape;
 
         fixture = body.CreateFixture(&fixtureDef);
+        numFixtures = 1;
     }
 
+    void CBox2DEdgeCollider::CreateFixture(b2Body & body, ShapeCache & /* cache */)
+    {
+        b2FixtureDef fixtureDef;
+
+        ConfigureFixtureDef(fixtureDef);
+
+        const b2Vec2 offset(GetOffset().x, GetOffset().y);
+        b2EdgeShape shape;
+        if (oneSided) {
+            shape.SetOneSided(
+                b2Vec2(v0.x, v0.y) + offset, 
+                b2Vec2(v1.x, v1.y) + offset, 
+                b2Vec2(v2.x, v2.y) + offset, 
+                b2Vec2(v3.x, v3.y) + offset);
+        } else {
+            shape.SetTwoSided(b2Vec2(v1.x, v1.y) + offset, b2Vec2(v2.x, v2.y) + offset);
+        }
+        fixtureDef.shape = &shape;
+
+        fixture = body.CreateFixture(&fixtureDef);
+        numFixtures = 1;
+    }
+
+    std::shared_ptr<EntityComponent> CBox2DCompoundCollider::Clone()
+    {
+        // Sub-colliders are not shared between compounds.
+        auto result = std::make_shared<CBox2DCompoundCollider>(*this);
+        for (auto& col : result->colliders) {
+            col = std::dynamic_pointer_cast<CBodyCollider>(col->Clone());
+        }
+        return result;
+    }
+
+    void CBox2DCompoundCollider::CreateFixture(b2Body & body, ShapeCache & cache)
+    {
+        fixture = nullptr;
+        numFixtures = 0;
+        for (auto& col : colliders) {
+            auto boxCol = dynamic_cast<IBox2DCollider*>(col.get());
+            if (!boxCol) {
+                throw std::logic_error("Sub-colliders must be created by the Box2D physics system");
+            }
+            boxCol->SetOwner(this);
+            boxCol->CreateFixture(body, cache);
+        }
+    }
+
+    void CBox2DCompoundCollider::ClearOverlaps()
+    {
+        CBox2DBaseCollider::ClearOverlaps();
+        for (auto& col : colliders) {
+            if (auto boxCol = dynamic_cast<IBox2DCollider*>(col.get())) {
+                boxCol->ClearOverlaps();
+            }
+        }
+    }
+
+    void CBox2DCompoundCollider::ReleaseFixtures()
+    {
+        CBox2DBaseCollider::ReleaseFixtures();
+        for (auto& col : colliders) {
+            if (auto boxCol = dynamic_cast<IBox2DCollider*>(col.get())) {
+                boxCol->ReleaseFixtures();
+            }
+        }
+    }
+
+    void CBox2DCompoundCollider::SetSystem(Box2DPhysicsSystem* system)
+    {
+        CBox2DBaseCollider::SetSystem(system);
+        for (auto& col : colliders) {
+            if (auto boxCol = dynamic_cast<IBox2DCollider*>(col.get())) {
+                boxCol->SetSystem(system);
+            }
+        }
+    }
 
 } // end of namespace
@@ -0,0 +1,89 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "CommandQueue.h"
+
+// C++ Standard Library includes
+#include <atomic>
+
+using namespace std;
+
+namespace astu::suite2d {
+
+    /** The identifier of the next queue. */
+    static atomic<uint64_t> nextQueueId(1);
+
+    /**
+     * The buffer of the queue used last by the current thread.
+     */
+    struct CachedBuffer {
+
+        /** The identifier of the queue. */
+        uint64_t queueId = 0;
+
+        /** The buffer of the current thread within that queue. */
+        CommandBuffer* buffer = nullptr;
+    };
+
+    static thread_local CachedBuffer cached;
+
+    CommandQueue::CommandQueue()
+        : id(nextQueueId.fetch_add(1))
+    {
+        // Intentionally left empty.
+    }
+
+    CommandBuffer& CommandQueue::GetBuffer()
+    {
+        if (cached.queueId == id) {
+            return *cached.buffer;
+        }
+
+        lock_guard<mutex> lock(bufferMutex);
+        const auto thread = this_thread::get_id();
+        CommandBuffer* result = nullptr;
+        for (auto& entry : buffers) {
+            if (entry.first == thread) {
+                result = entry.second.get();
+                break;
+            }
+        }
+
+        if (!result) {
+            buffers.emplace_back(thread, make_unique<CommandBuffer>());
+            result = buffers.back().second.get();
+        }
+
+        cached.queueId = id;
+        cached.buffer = result;
+        return *result;
+    }
+
+    size_t CommandQueue::Size()
+    {
+        lock_guard<mutex> lock(bufferMutex);
+        size_t result = 0;
+        for (auto& entry : buffers) {
+            result += entry.second->bodies.size() + entry.second->colliders.size();
+        }
+        return result;
+    }
+
+    size_t CommandQueue::GetMemoryUsage()
+    {
+        lock_guard<mutex> lock(bufferMutex);
+        size_t result = buffers.capacity() * sizeof(buffers[0]);
+        for (auto& entry : buffers) {
+            result += sizeof(CommandBuffer)
+                + entry.second->bodies.capacity() * sizeof(CBox2DBody*)
+                + entry.second->colliders.capacity() * sizeof(IBox2DCollider*);
+        }
+        return result;
+    }
+
+} // end of namespace
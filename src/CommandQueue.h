@@ -0,0 +1,122 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+#pragma once
+
+// C++ Standard Library includes
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace astu::suite2d {
+
+    // Forward declaration
+    class CBox2DBody;
+    class IBox2DCollider;
+
+    /**
+     * The bodies and colliders with pending changes issued by one thread.
+     *
+     * Bodies and colliders keep their pending changes themselves and are
+     * listed once, no matter how many changes have been issued. Entries
+     * of bodies and colliders destroyed before their changes have been
+     * applied are set to `nullptr`.
+     */
+    struct CommandBuffer {
+
+        /** The bodies with pending changes. */
+        std::vector<CBox2DBody*> bodies;
+
+        /** The colliders with pending changes. */
+        std::vector<IBox2DCollider*> colliders;
+    };
+
+    /**
+     * A collider with pending changes, keyed by its position in the world.
+     *
+     * The key does not depend on the thread which issued the changes,
+     * hence ordering by it keeps the simulation reproducible.
+     */
+    struct ColliderCommand {
+
+        /** The binding index of the body owning the collider, -1 if none. */
+        int bindingIndex;
+
+        /** The index of the last fixture of the collider within its body. */
+        uint16_t fixtureIndex;
+
+        /** The collider with pending changes. */
+        IBox2DCollider* collider;
+    };
+
+    /**
+     * Collects the bodies and colliders with pending changes.
+     *
+     * Each thread appends to a buffer of its own, hence threads issuing
+     * changes do not synchronize with each other. A lock is only taken
+     * the first time a thread uses this queue or after it has used
+     * another queue.
+     */
+    class CommandQueue {
+    public:
+
+        /**
+         * Constructor.
+         */
+        CommandQueue();
+
+        /**
+         * Returns the buffer of the calling thread.
+         *
+         * @return the command buffer
+         */
+        CommandBuffer& GetBuffer();
+
+        /**
+         * Calls a function for the buffer of each thread.
+         *
+         * Must not be called while other threads issue changes.
+         *
+         * @param func  the function to call
+         */
+        template <typename F>
+        void ForEachBuffer(F func) {
+            std::lock_guard<std::mutex> lock(bufferMutex);
+            for (auto& entry : buffers) {
+                func(*entry.second);
+            }
+        }
+
+        /**
+         * Returns the number of listed bodies and colliders.
+         *
+         * @return the number of entries of all buffers
+         */
+        size_t Size();
+
+        /**
+         * Returns the memory allocated by the buffers.
+         *
+         * @return the allocated memory in bytes
+         */
+        size_t GetMemoryUsage();
+
+    private:
+        /** Identifies this queue, unlike its address it is never reused. */
+        uint64_t id;
+
+        /** Guards the list of buffers. */
+        std::mutex bufferMutex;
+
+        /** The buffers and the threads owning them. */
+        std::vector<std::pair<std::thread::id, std::unique_ptr<CommandBuffer>>> buffers;
+    };
+
+} // end of namespace
@@ -0,0 +1,152 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "Profiler.h"
+
+// C++ Standard Library includes
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+
+namespace astu::suite2d {
+
+    /**
+     * Returns the member of the statistics holding a timing.
+     *
+     * @param metric    the timing
+     * @return pointer to the member
+     */
+    static double StepStats::* GetMember(ProfileMetric metric)
+    {
+        switch (metric) {
+        case ProfileMetric::Update:
+            return &StepStats::updateTime;
+        case ProfileMetric::Spawn:
+            return &StepStats::spawnTime;
+        case ProfileMetric::Collect:
+            return &StepStats::collectTime;
+        case ProfileMetric::Step:
+            return &StepStats::stepTime;
+        case ProfileMetric::Collide:
+            return &StepStats::collideTime;
+        case ProfileMetric::Solve:
+            return &StepStats::solveTime;
+        case ProfileMetric::Broadphase:
+            return &StepStats::broadphaseTime;
+        case ProfileMetric::SolveTOI:
+            return &StepStats::solveTOITime;
+        case ProfileMetric::Deploy:
+            return &StepStats::deployTime;
+        case ProfileMetric::Dispatch:
+        default:
+            return &StepStats::dispatchTime;
+        }
+    }
+
+    /**
+     * Returns a percentile of sorted values using the nearest rank.
+     *
+     * @param sorted    the sorted values, must not be empty
+     * @param p         the percentile within [0, 100]
+     * @return the percentile
+     */
+    static double Percentile(const vector<double>& sorted, double p)
+    {
+        size_t rank = static_cast<size_t>(ceil(p / 100.0 * sorted.size()));
+        return sorted[rank > 0 ? rank - 1 : 0];
+    }
+
+    Profiler::Profiler(size_t windowSize)
+        : samples(windowSize)
+        , nextSample(0)
+        , numSamples(0)
+        , firstEvent(true)
+        , epoch(Clock::now())
+    {
+        scratch.reserve(windowSize);
+    }
+
+    Profiler::~Profiler()
+    {
+        CloseTrace();
+    }
+
+    void Profiler::OpenTrace(const string& filename)
+    {
+        CloseTrace();
+        trace.open(filename, ios::out | ios::trunc);
+        if (!trace) {
+            throw std::runtime_error("Unable to open trace file '" + filename + "'");
+        }
+        trace << "[";
+        firstEvent = true;
+    }
+
+    void Profiler::CloseTrace()
+    {
+        if (trace.is_open()) {
+            trace << "\n]\n";
+            trace.close();
+        }
+    }
+
+    double Profiler::EndPhase(const char* name, Clock::time_point start)
+    {
+        auto end = Clock::now();
+        if (trace.is_open()) {
+            using us = chrono::duration<double, micro>;
+            trace << (firstEvent ? "\n" : ",\n")
+                << "{\"name\":\"" << name 
+                << "\",\"cat\":\"physics\",\"ph\":\"X\",\"ts\":" << us(start - epoch).count()
+                << ",\"dur\":" << us(end - start).count()
+                << ",\"pid\":1,\"tid\":" << hash<thread::id>()(this_thread::get_id()) % 100000
+                << "}";
+            firstEvent = false;
+        }
+        return chrono::duration<double, milli>(end - start).count();
+    }
+
+    void Profiler::AddSample(const StepStats& stats)
+    {
+        samples[nextSample] = stats;
+        nextSample = (nextSample + 1) % samples.size();
+        numSamples = min(numSamples + 1, samples.size());
+    }
+
+    ProfileSummary Profiler::Summarize(ProfileMetric metric) const
+    {
+        ProfileSummary summary;
+        if (numSamples == 0) {
+            return summary;
+        }
+
+        auto member = GetMember(metric);
+        scratch.clear();
+        double sum = 0;
+        for (size_t i = 0; i < numSamples; ++i) {
+            double value = samples[i].*member;
+            scratch.push_back(value);
+            sum += value;
+        }
+        sort(scratch.begin(), scratch.end());
+
+        summary.numSamples = numSamples;
+        summary.min = scratch.front();
+        summary.max = scratch.back();
+        summary.mean = sum / numSamples;
+        summary.p50 = Percentile(scratch, 50);
+        summary.p95 = Percentile(scratch, 95);
+        summary.p99 = Percentile(scratch, 99);
+        return summary;
+    }
+
+} // end of namespace
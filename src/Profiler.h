@@ -0,0 +1,105 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+#pragma once
+
+// Local includes
+#include "Box2DStepStats.h"
+
+// C++ Standard Library includes
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace astu::suite2d {
+
+    /**
+     * Keeps the statistics of recent updates and writes trace files.
+     *
+     * Trace files use the Chrome trace event format and can be viewed
+     * with `chrome://tracing` or Perfetto.
+     */
+    class Profiler {
+    public:
+
+        /** The clock used to measure timings. */
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * Constructor.
+         *
+         * @param windowSize    the number of updates kept
+         */
+        explicit Profiler(size_t windowSize);
+
+        /**
+         * Destructor, closes the trace file.
+         */
+        ~Profiler();
+
+        /**
+         * Opens a trace file, replacing the current one.
+         *
+         * @param filename  the name of the trace file
+         * @throws std::runtime_error in case the file cannot be opened
+         */
+        void OpenTrace(const std::string& filename);
+
+        /**
+         * Closes the current trace file, if any.
+         */
+        void CloseTrace();
+
+        /**
+         * Ends a phase, adds it to the trace file if one is open.
+         *
+         * @param name  the name of the phase
+         * @param start the start time of the phase
+         * @return the duration of the phase in milliseconds
+         */
+        double EndPhase(const char* name, Clock::time_point start);
+
+        /**
+         * Adds the statistics of an update to the window.
+         *
+         * @param stats the statistics of the update
+         */
+        void AddSample(const StepStats& stats);
+
+        /**
+         * Summarizes a timing over the updates of the window.
+         *
+         * @param metric    the timing to summarize
+         * @return the summary
+         */
+        ProfileSummary Summarize(ProfileMetric metric) const;
+
+    private:
+        /** The statistics of recent updates, used as ring buffer. */
+        std::vector<StepStats> samples;
+
+        /** The index of the next sample to be overwritten. */
+        size_t nextSample;
+
+        /** The number of valid samples. */
+        size_t numSamples;
+
+        /** Used to sort values when computing percentiles. */
+        mutable std::vector<double> scratch;
+
+        /** The trace file. */
+        std::ofstream trace;
+
+        /** Whether an event has been written to the trace file. */
+        bool firstEvent;
+
+        /** The point in time trace timestamps refer to. */
+        Clock::time_point epoch;
+    };
+
+} // end of namespace
@@ -0,0 +1,43 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+#pragma once
+
+namespace astu {
+
+    // Forward declaration
+    class Entity;
+
+}
+
+namespace astu::suite2d {
+
+    // Forward declaration
+    class IBox2DCollider;
+
+    /**
+     * A contact of a sensor which began or ended touching during a step.
+     *
+     * Recorded while stepping and applied to the overlap sets afterwards,
+     * since the overlap sets may be read while the world is stepped.
+     */
+    struct SensorContact {
+
+        /** The sensor collider. */
+        IBox2DCollider* sensor;
+
+        /** The entity owning the sensor. */
+        Entity* sensorEntity;
+
+        /** The entity touching the sensor. */
+        Entity* entity;
+
+        /** Whether the contact began touching. */
+        bool begin;
+    };
+
+} // end of namespace
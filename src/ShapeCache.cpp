@@ -0,0 +1,320 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "ShapeCache.h"
+
+// Box2D includes
+#include <box2d/b2_math.h>
+
+// C++ Standard Library includes
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+using namespace std;
+
+namespace astu::suite2d {
+
+    /**
+     * The tolerance for collinear vertices relative to the squared extent
+     * of the polygon, well above the rounding error of the cross product.
+     */
+    static const float COLLINEAR_TOLERANCE = 1.0e-6f;
+
+    /**
+     * Computes the doubled signed area of a triangle.
+     */
+    static inline float Cross(const b2Vec2& a, const b2Vec2& b, const b2Vec2& c)
+    {
+        return b2Cross(b - a, c - a);
+    }
+
+    /**
+     * Tests whether a point lies within or on a counter-clockwise triangle.
+     */
+    static bool InTriangle(const b2Vec2& p, const b2Vec2& a, const b2Vec2& b, const b2Vec2& c)
+    {
+        return Cross(a, b, p) >= 0 && Cross(b, c, p) >= 0 && Cross(c, a, p) >= 0;
+    }
+
+    /**
+     * Tests whether a counter-clockwise polygon given by indices is convex.
+     */
+    static bool IsConvex(const vector<b2Vec2>& vertices, const vector<int>& piece)
+    {
+        const size_t n = piece.size();
+        for (size_t i = 0; i < n; ++i) {
+            const b2Vec2& a = vertices[piece[i]];
+            const b2Vec2& b = vertices[piece[(i + 1) % n]];
+            const b2Vec2& c = vertices[piece[(i + 2) % n]];
+            if (Cross(a, b, c) < 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Removes duplicate and collinear vertices.
+     *
+     * Vertices closer than the linear slop are duplicates. The tolerance
+     * for collinear vertices scales with the extent of the polygon, hence
+     * small polygons keep their features and large polygons do not keep
+     * vertices which only deviate from a straight edge by rounding errors.
+     */
+    static void Simplify(vector<b2Vec2>& vertices)
+    {
+        if (vertices.empty()) {
+            return;
+        }
+
+        b2Vec2 lower = vertices[0];
+        b2Vec2 upper = vertices[0];
+        for (const auto& v : vertices) {
+            lower = b2Min(lower, v);
+            upper = b2Max(upper, v);
+        }
+        const b2Vec2 size = upper - lower;
+        const float extent = b2Max(size.x, size.y);
+        const float tolSqr = b2_linearSlop * b2_linearSlop;
+        const float collinearTol = COLLINEAR_TOLERANCE * extent * extent;
+
+        bool changed = true;
+        while (changed && vertices.size() >= 3) {
+            changed = false;
+            for (size_t i = 0; i < vertices.size() && vertices.size() >= 3; ++i) {
+                const size_t n = vertices.size();
+                const b2Vec2& prev = vertices[(i + n - 1) % n];
+                const b2Vec2& cur = vertices[i];
+                const b2Vec2& next = vertices[(i + 1) % n];
+                if (b2DistanceSquared(prev, cur) < tolSqr 
+                    || std::abs(Cross(prev, cur, next)) < collinearTol) 
+                {
+                    vertices.erase(vertices.begin() + i);
+                    changed = true;
+                    --i;
+                }
+            }
+        }
+    }
+
+    /**
+     * Triangulates a counter-clockwise simple polygon by ear clipping.
+     *
+     * @throws std::logic_error in case the polygon is not simple
+     */
+    static void Triangulate(const vector<b2Vec2>& vertices, vector<vector<int>>& triangles)
+    {
+        vector<int> remaining(vertices.size());
+        for (size_t i = 0; i < remaining.size(); ++i) {
+            remaining[i] = static_cast<int>(i);
+        }
+
+        size_t guard = 0;
+        size_t i = 0;
+        while (remaining.size() > 3) {
+            const size_t n = remaining.size();
+            const int ia = remaining[(i + n - 1) % n];
+            const int ib = remaining[i % n];
+            const int ic = remaining[(i + 1) % n];
+            const b2Vec2& a = vertices[ia];
+            const b2Vec2& b = vertices[ib];
+            const b2Vec2& c = vertices[ic];
+
+            bool ear = Cross(a, b, c) > 0;
+            for (size_t j = 0; ear && j < n; ++j) {
+                int k = remaining[j];
+                if (k != ia && k != ib && k != ic && InTriangle(vertices[k], a, b, c)) {
+                    ear = false;
+                }
+            }
+
+            if (ear) {
+                triangles.push_back({ia, ib, ic});
+                remaining.erase(remaining.begin() + (i % n));
+                guard = 0;
+            } else {
+                ++i;
+                if (++guard > n) {
+                    // No ear left, a partial triangulation would drop parts of the polygon.
+                    throw std::logic_error("Polygon collider is not a simple polygon");
+                }
+            }
+        }
+        triangles.push_back({remaining[0], remaining[1], remaining[2]});
+    }
+
+    /**
+     * Merges adjacent convex pieces as long as the result stays convex
+     * and does not exceed the maximum number of vertices (Hertel-Mehlhorn).
+     */
+    static void MergePieces(const vector<b2Vec2>& vertices, vector<vector<int>>& pieces)
+    {
+        bool merged = true;
+        while (merged) {
+            merged = false;
+            for (size_t p = 0; p < pieces.size() && !merged; ++p) {
+                for (size_t q = p + 1; q < pieces.size() && !merged; ++q) {
+                    auto& a = pieces[p];
+                    auto& b = pieces[q];
+                    if (a.size() + b.size() - 2 > b2_maxPolygonVertices) {
+                        continue;
+                    }
+
+                    // Find an edge (u, v) of a which is edge (v, u) of b.
+                    for (size_t i = 0; i < a.size() && !merged; ++i) {
+                        int u = a[i];
+                        int v = a[(i + 1) % a.size()];
+                        for (size_t j = 0; j < b.size(); ++j) {
+                            if (b[j] != v || b[(j + 1) % b.size()] != u) {
+                                continue;
+                            }
+
+                            vector<int> candidate;
+                            candidate.reserve(a.size() + b.size() - 2);
+                            for (size_t k = 0; k < a.size(); ++k) {
+                                candidate.push_back(a[(i + 1 + k) % a.size()]);
+                            }
+                            // Starts at v and ends at u, append b without u and v.
+                            for (size_t k = 2; k < b.size(); ++k) {
+                                candidate.push_back(b[(j + k) % b.size()]);
+                            }
+
+                            if (IsConvex(vertices, candidate)) {
+                                a = move(candidate);
+                                pieces.erase(pieces.begin() + q);
+                                merged = true;
+                            }
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void ShapeCache::Decompose(vector<b2Vec2> vertices, vector<b2PolygonShape>& shapes)
+    {
+        Simplify(vertices);
+        if (vertices.size() < 3) {
+            throw std::logic_error("Polygon collider is degenerate");
+        }
+
+        // Ensure counter-clockwise winding.
+        float area = 0;
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            area += b2Cross(vertices[i], vertices[(i + 1) % vertices.size()]);
+        }
+        if (area < 0) {
+            reverse(vertices.begin(), vertices.end());
+        }
+
+        vector<vector<int>> pieces;
+        vector<int> whole(vertices.size());
+        for (size_t i = 0; i < whole.size(); ++i) {
+            whole[i] = static_cast<int>(i);
+        }
+
+        if (vertices.size() <= b2_maxPolygonVertices && IsConvex(vertices, whole)) {
+            pieces.push_back(move(whole));
+        } else {
+            Triangulate(vertices, pieces);
+            MergePieces(vertices, pieces);
+        }
+
+        b2Vec2 points[b2_maxPolygonVertices];
+        for (const auto& piece : pieces) {
+            for (size_t i = 0; i < piece.size(); ++i) {
+                points[i] = vertices[piece[i]];
+            }
+
+            b2PolygonShape shape;
+            if (!shape.Set(points, static_cast<int32>(piece.size()))) {
+                throw std::logic_error("Polygon collider contains a degenerate piece");
+            }
+            shapes.push_back(shape);
+        }
+    }
+
+    size_t ShapeCache::KeyHash::operator()(const Key& key) const
+    {
+        size_t h = hash<const void*>()(key.polygon);
+        h ^= hash<float>()(key.ox) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        h ^= hash<float>()(key.oy) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        return h;
+    }
+
+    const vector<b2PolygonShape>& ShapeCache::GetShapes(const shared_ptr<Polygon>& polygon, float ox, float oy)
+    {
+        Key key{polygon.get(), ox, oy};
+        auto it = entries.find(key);
+        if (it != entries.end()) {
+            // A destroyed polygon might have occupied the same address.
+            const auto& cached = it->second.polygon;
+            if (!cached.owner_before(polygon) && !polygon.owner_before(cached)) {
+                return it->second.shapes;
+            }
+            entries.erase(it);
+        }
+
+        vector<b2Vec2> vertices;
+        vertices.reserve(polygon->GetVertices().size());
+        for (const auto& vtx : polygon->GetVertices()) {
+            vertices.push_back(b2Vec2(vtx.x + ox, vtx.y + oy));
+        }
+
+        // Decomposed before the entry is added, invalid polygons are not cached.
+        vector<b2PolygonShape> shapes;
+        Decompose(move(vertices), shapes);
+
+        // Purging whenever the cache has doubled keeps the cost amortized.
+        if (entries.size() >= purgeSize) {
+            Purge();
+            purgeSize = max(MIN_PURGE_SIZE, entries.size() * 2);
+        }
+
+        Entry& entry = entries[key];
+        entry.polygon = polygon;
+        entry.shapes = move(shapes);
+        return entry.shapes;
+    }
+
+    void ShapeCache::Invalidate(const Polygon& polygon)
+    {
+        for (auto it = entries.begin(); it != entries.end(); ) {
+            if (it->first.polygon == &polygon) {
+                it = entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void ShapeCache::Purge()
+    {
+        for (auto it = entries.begin(); it != entries.end(); ) {
+            if (it->second.polygon.expired()) {
+                it = entries.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    size_t ShapeCache::GetMemoryUsage() const
+    {
+        // Each node of the hash table holds an entry and a link.
+        size_t bytes = entries.bucket_count() * sizeof(void*)
+            + entries.size() * (sizeof(Key) + sizeof(Entry) + sizeof(void*));
+        for (const auto& it : entries) {
+            bytes += it.second.shapes.capacity() * sizeof(b2PolygonShape);
+        }
+        return bytes;
+    }
+
+} // end of namespace
@@ -0,0 +1,143 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+#pragma once
+
+// AST-Utilities includes
+#include <Math/Polygon.h>
+
+// Box2D includes
+#include <box2d/b2_polygon_shape.h>
+
+// C++ Standard Library includes
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace astu::suite2d {
+
+    /**
+     * Caches Box2D polygon shapes cooked from polygons.
+     *
+     * Shapes are keyed by the identity of the source polygon and the
+     * offset of the collider, hence colliders sharing a polygon reuse the
+     * cooked shapes. Concave polygons and polygons exceeding the maximum
+     * number of vertices supported by Box2D are decomposed into several
+     * convex shapes.
+     *
+     * Entries do not keep their polygons alive. Entries of destroyed
+     * polygons are purged from time to time, an entry found for a new
+     * polygon which occupies the address of a destroyed one is cooked
+     * again.
+     *
+     * Polygons are considered immutable once they have been cooked. A
+     * polygon changed afterwards must be invalidated, otherwise its stale
+     * shapes are returned. Fixtures copy their shapes, hence invalidating
+     * does not affect existing fixtures.
+     */
+    class ShapeCache {
+    public:
+
+        /**
+         * Returns the cooked shapes of a polygon.
+         *
+         * @param polygon   the source polygon
+         * @param ox        the x-coordinate of the offset
+         * @param oy        the y-coordinate of the offset
+         * @return the convex shapes making up the polygon
+         * @throws std::logic_error in case the polygon is not simple or degenerate
+         */
+        const std::vector<b2PolygonShape>& GetShapes(const std::shared_ptr<Polygon>& polygon, float ox, float oy);
+
+        /**
+         * Returns the number of cached polygons.
+         *
+         * @return the number of cache entries
+         */
+        size_t Size() const {
+            return entries.size();
+        }
+
+        /**
+         * Returns the memory allocated by this cache.
+         *
+         * The overhead of the hash table is estimated.
+         *
+         * @return the allocated memory in bytes
+         */
+        size_t GetMemoryUsage() const;
+
+        /**
+         * Removes the cooked shapes of a polygon for all offsets.
+         *
+         * @param polygon   the polygon which has been changed
+         */
+        void Invalidate(const Polygon& polygon);
+
+        /**
+         * Removes the entries of destroyed polygons.
+         */
+        void Purge();
+
+        /**
+         * Removes all cooked shapes.
+         */
+        void Clear() {
+            entries.clear();
+            purgeSize = MIN_PURGE_SIZE;
+        }
+
+        /**
+         * Decomposes a simple polygon into convex pieces.
+         *
+         * Each piece has at most `b2_maxPolygonVertices` vertices.
+         *
+         * @param vertices  the vertices of the polygon
+         * @param shapes    receives the convex shapes
+         * @throws std::logic_error in case the polygon is not simple or degenerate
+         */
+        static void Decompose(std::vector<b2Vec2> vertices, std::vector<b2PolygonShape>& shapes);
+
+    private:
+
+        /** The key of cache entries. */
+        struct Key {
+            const Polygon* polygon;
+            float ox;
+            float oy;
+
+            bool operator==(const Key& o) const {
+                return polygon == o.polygon && ox == o.ox && oy == o.oy;
+            }
+        };
+
+        /** Computes hash values of keys. */
+        struct KeyHash {
+            size_t operator()(const Key& key) const;
+        };
+
+        /** A cache entry. */
+        struct Entry {
+            /** The source polygon, its address is part of the key. */
+            std::weak_ptr<Polygon> polygon;
+
+            /** The convex shapes making up the polygon. */
+            std::vector<b2PolygonShape> shapes;
+        };
+
+        /** The number of entries below which the cache is never purged. */
+        static constexpr size_t MIN_PURGE_SIZE = 64;
+
+        /** The cached shapes. */
+        std::unordered_map<Key, Entry, KeyHash> entries;
+
+        /** The number of entries from which on the cache is purged before growing. */
+        size_t purgeSize = MIN_PURGE_SIZE;
+    };
+
+} // end of namespace
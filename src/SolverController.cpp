@@ -0,0 +1,96 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "SolverController.h"
+
+// C++ Standard Library includes
+#include <algorithm>
+
+using namespace std;
+
+namespace astu::suite2d {
+
+    /** The weight of new measurements in the moving averages. */
+    static const double SMOOTHING = 0.2;
+
+    SolverController::SolverController(const SolverBudget& budget)
+        : budget(budget)
+        , level(0)
+        , avgStepTime(0)
+        , avgContacts(0)
+        , numSettleSteps(0)
+    {
+        // Intentionally left empty.
+    }
+
+    bool SolverController::Update(double stepTime, size_t numContacts, const SolverLevel& best)
+    {
+        if (avgStepTime == 0) {
+            avgStepTime = stepTime;
+            avgContacts = static_cast<double>(numContacts);
+        } else {
+            avgStepTime += SMOOTHING * (stepTime - avgStepTime);
+            avgContacts += SMOOTHING * (numContacts - avgContacts);
+        }
+
+        if (++numSettleSteps < budget.settleSteps) {
+            return false;
+        }
+
+        double expected = avgStepTime;
+        if (avgContacts > 0 && numContacts > avgContacts) {
+            expected *= numContacts / avgContacts;
+        }
+
+        int newLevel = level;
+        if (expected > budget.stepTime) {
+            newLevel = min(level + 1, GetMaxLevel(best));
+        } else if (expected < budget.stepTime * (1.0 - budget.hysteresis)) {
+            newLevel = max(level - 1, 0);
+        }
+
+        if (newLevel == level) {
+            return false;
+        }
+        level = newLevel;
+        numSettleSteps = 0;
+        return true;
+    }
+
+    SolverLevel SolverController::GetSettings(const SolverLevel& best) const
+    {
+        SolverLevel result = best;
+        result.level = min(level, GetMaxLevel(best));
+
+        int remaining = result.level;
+        int n = min(remaining, max(best.velocityIterations - budget.minVelocityIterations, 0));
+        result.velocityIterations -= n;
+        remaining -= n;
+
+        n = min(remaining, max(best.positionIterations - budget.minPositionIterations, 0));
+        result.positionIterations -= n;
+        remaining -= n;
+
+        if (remaining > 0 && budget.allowDiscrete && best.continuousPhysics) {
+            result.continuousPhysics = false;
+            --remaining;
+        }
+
+        result.maxSubSteps -= remaining;
+        return result;
+    }
+
+    int SolverController::GetMaxLevel(const SolverLevel& best) const
+    {
+        return max(best.velocityIterations - budget.minVelocityIterations, 0)
+            + max(best.positionIterations - budget.minPositionIterations, 0)
+            + (budget.allowDiscrete && best.continuousPhysics ? 1 : 0)
+            + max(best.maxSubSteps - budget.minSubSteps, 0);
+    }
+
+} // end of namespace
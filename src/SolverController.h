@@ -0,0 +1,88 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+#pragma once
+
+// Local includes
+#include "Box2DSolverBudget.h"
+
+// C++ Standard Library includes
+#include <cstddef>
+
+namespace astu::suite2d {
+
+    /**
+     * Chooses solver settings which keep step times within a budget.
+     *
+     * Step times and contact counts are smoothed by exponential moving
+     * averages. A rising contact count scales the expected step time
+     * before it shows in the measurements, hence contact-heavy moments
+     * lower the quality one step earlier.
+     */
+    class SolverController {
+    public:
+
+        /**
+         * Constructor.
+         *
+         * @param budget    the time budget and the lower quality bounds
+         */
+        explicit SolverController(const SolverBudget& budget);
+
+        /**
+         * Returns the time budget and the lower quality bounds.
+         *
+         * @return the solver budget
+         */
+        const SolverBudget& GetBudget() const {
+            return budget;
+        }
+
+        /**
+         * Accounts for a step and adjusts the quality level if required.
+         *
+         * @param stepTime      the measured time of the step in milliseconds
+         * @param numContacts   the number of contacts after the step
+         * @param best          the settings of the highest quality
+         * @return `true` if the quality level has changed
+         */
+        bool Update(double stepTime, size_t numContacts, const SolverLevel& best);
+
+        /**
+         * Returns the settings of the current quality level.
+         *
+         * @param best  the settings of the highest quality
+         * @return the settings of the current level
+         */
+        SolverLevel GetSettings(const SolverLevel& best) const;
+
+    private:
+        /** The time budget and the lower quality bounds. */
+        SolverBudget budget;
+
+        /** The current quality level, zero is the highest quality. */
+        int level;
+
+        /** The average step time in milliseconds. */
+        double avgStepTime;
+
+        /** The average number of contacts. */
+        double avgContacts;
+
+        /** The number of steps since the last adjustment. */
+        int numSettleSteps;
+
+        /**
+         * Returns the lowest quality level.
+         *
+         * @param best  the settings of the highest quality
+         * @return the number of levels below the highest quality
+         */
+        int GetMaxLevel(const SolverLevel& best) const;
+    };
+
+} // end of namespace
@@ -0,0 +1,288 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "StepRecorder.h"
+
+// C++ Standard Library includes
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+namespace astu::suite2d {
+
+    /**
+     * Mixes a float into a hash value (FNV-1a on 32-bit words).
+     */
+    static inline uint64_t Mix(uint64_t h, float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return (h ^ bits) * 0x100000001b3ull;
+    }
+
+    uint64_t HashWorldState(const b2World& world)
+    {
+        uint64_t h = 0xcbf29ce484222325ull;
+        for (auto body = world.GetBodyList(); body; body = body->GetNext()) {
+            if (body->GetType() == b2_staticBody) {
+                continue;
+            }
+
+            // Sleeping bodies are hashed as well, their poses might have
+            // been changed from outside.
+            h = (h ^ (body->IsAwake() ? 1u : 0u)) * 0x100000001b3ull;
+            const b2Transform& xf = body->GetTransform();
+            const b2Vec2& v = body->GetLinearVelocity();
+            h = Mix(h, xf.p.x);
+            h = Mix(h, xf.p.y);
+            h = Mix(h, xf.q.s);
+            h = Mix(h, xf.q.c);
+            h = Mix(h, v.x);
+            h = Mix(h, v.y);
+            h = Mix(h, body->GetAngularVelocity());
+        }
+        return h;
+    }
+
+    uint16_t GetFixtureIndex(const b2Fixture& fixture)
+    {
+        uint16_t idx = 0;
+        for (auto f = fixture.GetBody()->GetFixtureList(); f != &fixture; f = f->GetNext()) {
+            ++idx;
+        }
+        return idx;
+    }
+
+    StepRecorder::StepRecorder(const string& filename, const b2World& world, const WorldCapacity& capacity)
+        : out(filename, ios::out | ios::binary | ios::trunc)
+    {
+        if (!out) {
+            throw std::runtime_error("Unable to open recording file '" + filename + "'");
+        }
+
+        Put(RECORDING_MAGIC);
+        Put(RECORDING_VERSION);
+        WriteCreateWorld(world, capacity);
+
+        // The body list starts with the newest body, record oldest first.
+        vector<const b2Body*> bodies;
+        for (auto body = world.GetBodyList(); body; body = body->GetNext()) {
+            bodies.push_back(body);
+        }
+        for (auto it = bodies.rbegin(); it != bodies.rend(); ++it) {
+            WriteSpawn(**it);
+        }
+    }
+
+    StepRecorder::~StepRecorder()
+    {
+        out.flush();
+    }
+
+    void StepRecorder::WriteSpawn(const b2Body& body)
+    {
+        Put(RecordTag::Spawn);
+        PutId(body);
+        Put(static_cast<uint8_t>(body.GetType()));
+        Put(body.GetPosition().x);
+        Put(body.GetPosition().y);
+        Put(body.GetAngle());
+        Put(body.GetLinearVelocity().x);
+        Put(body.GetLinearVelocity().y);
+        Put(body.GetAngularVelocity());
+        Put(body.GetLinearDamping());
+        Put(body.GetAngularDamping());
+        Put(body.GetGravityScale());
+        uint8_t flags = (body.IsFixedRotation() ? 0x01 : 0)
+            | (body.IsBullet() ? 0x02 : 0)
+            | (body.IsAwake() ? 0x04 : 0)
+            | (body.IsSleepingAllowed() ? 0x08 : 0)
+            | (body.IsEnabled() ? 0x10 : 0);
+        Put(flags);
+
+        // The fixture list starts with the newest fixture, record oldest first.
+        fixtures.clear();
+        for (auto f = body.GetFixtureList(); f; f = f->GetNext()) {
+            fixtures.push_back(f);
+        }
+        Put(static_cast<uint16_t>(fixtures.size()));
+        for (auto it = fixtures.rbegin(); it != fixtures.rend(); ++it) {
+            PutFixture(**it);
+        }
+    }
+
+    void StepRecorder::PutFixture(const b2Fixture& fixture)
+    {
+        const b2Filter& filter = fixture.GetFilterData();
+        Put(fixture.GetDensity());
+        Put(fixture.GetFriction());
+        Put(fixture.GetRestitution());
+        Put(fixture.GetRestitutionThreshold());
+        Put(filter.categoryBits);
+        Put(filter.maskBits);
+        Put(filter.groupIndex);
+        Put<uint8_t>(fixture.IsSensor() ? 1 : 0);
+
+        const b2Shape* shape = fixture.GetShape();
+        Put(static_cast<uint8_t>(shape->m_type));
+        Put(shape->m_radius);
+        switch (shape->m_type) {
+        case b2Shape::e_circle: {
+            auto circle = static_cast<const b2CircleShape*>(shape);
+            Put(circle->m_p);
+            break;
+        }
+
+        case b2Shape::e_edge: {
+            auto edge = static_cast<const b2EdgeShape*>(shape);
+            Put(edge->m_vertex0);
+            Put(edge->m_vertex1);
+            Put(edge->m_vertex2);
+            Put(edge->m_vertex3);
+            Put<uint8_t>(edge->m_oneSided ? 1 : 0);
+            break;
+        }
+
+        case b2Shape::e_polygon: {
+            // Written as computed by Box2D, replays must not recompute hulls.
+            auto polygon = static_cast<const b2PolygonShape*>(shape);
+            Put(polygon->m_centroid);
+            Put(polygon->m_count);
+            for (int32 i = 0; i < polygon->m_count; ++i) {
+                Put(polygon->m_vertices[i]);
+                Put(polygon->m_normals[i]);
+            }
+            break;
+        }
+
+        case b2Shape::e_chain: {
+            auto chain = static_cast<const b2ChainShape*>(shape);
+            Put(chain->m_count);
+            for (int32 i = 0; i < chain->m_count; ++i) {
+                Put(chain->m_vertices[i]);
+            }
+            Put(chain->m_prevVertex);
+            Put(chain->m_nextVertex);
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+
+    void StepRecorder::WriteDespawn(const b2Body& body)
+    {
+        Put(RecordTag::Despawn);
+        PutId(body);
+    }
+
+    void StepRecorder::WriteCommand(RecordTag tag, const b2Body& body, float x, float y)
+    {
+        Put(tag);
+        PutId(body);
+        Put(x);
+        Put(y);
+    }
+
+    void StepRecorder::WriteTeleport(const b2Body& body, float x, float y, float angle)
+    {
+        Put(RecordTag::Teleport);
+        PutId(body);
+        Put(x);
+        Put(y);
+        Put(angle);
+    }
+
+    void StepRecorder::WriteGravity(const b2Vec2& gravity)
+    {
+        Put(RecordTag::SetGravity);
+        Put(gravity);
+    }
+
+    void StepRecorder::WriteAllowSleeping(bool b)
+    {
+        Put(RecordTag::AllowSleeping);
+        Put<uint8_t>(b ? 1 : 0);
+    }
+
+    void StepRecorder::WriteContinuousPhysics(bool b)
+    {
+        Put(RecordTag::ContinuousPhysics);
+        Put<uint8_t>(b ? 1 : 0);
+    }
+
+    void StepRecorder::WriteCreateWorld(const b2World& world, const WorldCapacity& capacity)
+    {
+        Put(RecordTag::CreateWorld);
+        Put(world.GetGravity());
+        Put<uint8_t>(world.GetAllowSleeping() ? 1 : 0);
+        Put<uint8_t>(world.GetContinuousPhysics() ? 1 : 0);
+        PutCapacity(capacity);
+    }
+
+    void StepRecorder::WriteReserve(const WorldCapacity& capacity)
+    {
+        Put(RecordTag::Reserve);
+        PutCapacity(capacity);
+    }
+
+    void StepRecorder::PutCapacity(const WorldCapacity& capacity)
+    {
+        Put<uint64_t>(capacity.bodies);
+        Put<uint64_t>(capacity.fixtures);
+        Put<uint64_t>(capacity.contacts);
+    }
+
+    void StepRecorder::WriteFixture(const b2Fixture& fixture, uint8_t changes)
+    {
+        const b2Filter& filter = fixture.GetFilterData();
+        Put(RecordTag::SetFixture);
+        PutId(*fixture.GetBody());
+        Put(GetFixtureIndex(fixture));
+        Put(changes);
+        Put(fixture.GetDensity());
+        Put(fixture.GetFriction());
+        Put(fixture.GetRestitution());
+        Put(filter.categoryBits);
+        Put(filter.maskBits);
+        Put<uint8_t>(fixture.IsSensor() ? 1 : 0);
+    }
+
+    void StepRecorder::WriteContactImpulses(const b2Contact& contact)
+    {
+        const b2Fixture& fixtureA = *contact.GetFixtureA();
+        const b2Fixture& fixtureB = *contact.GetFixtureB();
+        const b2Manifold& manifold = *contact.GetManifold();
+        Put(RecordTag::ContactImpulses);
+        PutId(*fixtureA.GetBody());
+        PutId(*fixtureB.GetBody());
+        Put(GetFixtureIndex(fixtureA));
+        Put(GetFixtureIndex(fixtureB));
+        Put(contact.GetChildIndexA());
+        Put(contact.GetChildIndexB());
+        Put(static_cast<uint8_t>(manifold.pointCount));
+        for (int32 i = 0; i < manifold.pointCount; ++i) {
+            Put(manifold.points[i].id.key);
+            Put(manifold.points[i].normalImpulse);
+            Put(manifold.points[i].tangentImpulse);
+        }
+    }
+
+    void StepRecorder::WriteStep(float dt, int32 velocityIterations, int32 positionIterations, uint64_t hash)
+    {
+        Put(RecordTag::Step);
+        Put(dt);
+        Put(velocityIterations);
+        Put(positionIterations);
+        Put(hash);
+    }
+
+} // end of namespace
@@ -0,0 +1,306 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+#pragma once
+
+// Local includes
+#include "Box2DMemory.h"
+
+// Box2D includes
+#include <box2d/box2d.h>
+
+// C++ Standard Library includes
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace astu::suite2d {
+
+    /** Identifies recordings, 'B2RL' in little-endian byte order. */
+    static const uint32_t RECORDING_MAGIC = 0x4c523242;
+
+    /** The version of the recording format. */
+    static const uint16_t RECORDING_VERSION = 2;
+
+    /**
+     * The types of records stored in recordings.
+     *
+     * Each record starts with its tag, followed by the payload. Bodies
+     * are identified by the address of the Box2D body at recording time,
+     * which is unique while the body exists.
+     */
+    enum class RecordTag : uint8_t {
+        /** Body created: id, body state and fixtures. */
+        Spawn = 1,
+
+        /** Body destroyed: id. */
+        Despawn,
+
+        /** Body moved from outside: id, x, y, angle. */
+        Teleport,
+
+        /** Linear velocity set: id, vx, vy. */
+        SetLinearVelocity,
+
+        /** Angular velocity set: id, w. */
+        SetAngularVelocity,
+
+        /** Linear damping set: id, damping. */
+        SetLinearDamping,
+
+        /** Angular damping set: id, damping. */
+        SetAngularDamping,
+
+        /** Torque applied: id, torque. */
+        ApplyTorque,
+
+        /** Force applied to the center: id, fx, fy. */
+        ApplyForce,
+
+        /** Body type changed: id, type. */
+        SetType,
+
+        /** Gravity changed: gx, gy. */
+        SetGravity,
+
+        /** World stepped: dt, velocity iterations, position iterations, hash. */
+        Step,
+
+        /** Body woken up or put to sleep: id, awake. */
+        SetAwake,
+
+        /** Body enabled or disabled: id, enabled. */
+        SetEnabled,
+
+        /** Sleeping of a body allowed or prevented: id, allowed. */
+        SetSleepingAllowed,
+
+        /** Sleeping allowed or prevented for the world: allowed. */
+        AllowSleeping,
+
+        /** Continuous collision enabled or disabled for the world: enabled. */
+        ContinuousPhysics,
+
+        /**
+         * World replaced by an empty world: gravity, sleeping allowed,
+         * continuous physics and the reserved bodies, fixtures and contacts.
+         */
+        CreateWorld,
+
+        /** Capacity reserved for a world holding bodies: bodies, fixtures, contacts. */
+        Reserve,
+
+        /**
+         * Fixture properties changed: id, fixture index, changes, density,
+         * friction, restitution, category bits, mask bits and sensor.
+         */
+        SetFixture,
+
+        /**
+         * Warm-starting impulses of a contact: ids and fixture indices of
+         * both bodies, child indices, point count and the id, normal and
+         * tangent impulse of each point.
+         */
+        ContactImpulses,
+    };
+
+    /**
+     * The changes of fixture properties recorded by `SetFixture` records.
+     *
+     * Correspond to `ColliderChanges::Flags`, the properties are set in
+     * the order of their bits.
+     */
+    enum FixtureChanges : uint8_t {
+        FixtureRestitution = 0x01,
+        FixtureFriction = 0x02,
+        FixtureDensity = 0x04,
+        FixtureFilter = 0x08,
+        FixtureSensor = 0x10,
+    };
+
+    /**
+     * Returns the index of a fixture within the fixture list of its body.
+     *
+     * @param fixture   the fixture
+     * @return the number of fixtures preceding the fixture
+     */
+    uint16_t GetFixtureIndex(const b2Fixture& fixture);
+
+    /**
+     * Computes a hash of the state of all non-static bodies.
+     *
+     * Considers the awake state, the transform and the velocities of
+     * each body, regardless of whether it is asleep.
+     *
+     * @param world the Box2D world
+     * @return the hash value
+     */
+    uint64_t HashWorldState(const b2World& world);
+
+    /**
+     * Writes the inputs of a Box2D world to a recording file.
+     */
+    class StepRecorder {
+    public:
+
+        /**
+         * Constructor, opens the recording file and writes its header.
+         *
+         * The world must have been created with the specified capacity
+         * and must hold its bodies in the order they have been created
+         * in, i.e., the replay creates an identical world.
+         *
+         * @param filename  the name of the recording file
+         * @param world     the world to record, existing bodies are recorded
+         * @param capacity  the capacity reserved for the world
+         * @throws std::runtime_error in case the file cannot be opened
+         */
+        StepRecorder(const std::string& filename, const b2World& world, const WorldCapacity& capacity);
+
+        /**
+         * Destructor, flushes and closes the recording file.
+         */
+        ~StepRecorder();
+
+        /**
+         * Records the creation of a body including its fixtures.
+         *
+         * @param body  the new body
+         */
+        void WriteSpawn(const b2Body& body);
+
+        /**
+         * Records the destruction of a body.
+         *
+         * @param body  the body about to be destroyed
+         */
+        void WriteDespawn(const b2Body& body);
+
+        /**
+         * Records a command issued to a body.
+         *
+         * @param tag   the type of command
+         * @param body  the body
+         * @param x     the first argument
+         * @param y     the second argument, if required by the command
+         */
+        void WriteCommand(RecordTag tag, const b2Body& body, float x, float y = 0);
+
+        /**
+         * Records a transform set from outside.
+         *
+         * @param body  the body
+         * @param x     the x-coordinate of the position
+         * @param y     the y-coordinate of the position
+         * @param angle the angle
+         */
+        void WriteTeleport(const b2Body& body, float x, float y, float angle);
+
+        /**
+         * Records a change of gravity.
+         *
+         * @param gravity   the new gravity vector
+         */
+        void WriteGravity(const b2Vec2& gravity);
+
+        /**
+         * Records whether bodies are allowed to fall asleep.
+         *
+         * @param b `true` if sleeping is allowed
+         */
+        void WriteAllowSleeping(bool b);
+
+        /**
+         * Records whether continuous collision is enabled.
+         *
+         * @param b `true` if continuous collision is enabled
+         */
+        void WriteContinuousPhysics(bool b);
+
+        /**
+         * Records the replacement of the world by an empty world.
+         *
+         * @param world     the new world
+         * @param capacity  the capacity reserved for the world
+         */
+        void WriteCreateWorld(const b2World& world, const WorldCapacity& capacity);
+
+        /**
+         * Records the reservation of capacity for a world holding bodies.
+         *
+         * @param capacity  the reserved capacity
+         */
+        void WriteReserve(const WorldCapacity& capacity);
+
+        /**
+         * Records changed properties of a fixture.
+         *
+         * @param fixture   the fixture
+         * @param changes   the changed properties, see FixtureChanges
+         */
+        void WriteFixture(const b2Fixture& fixture, uint8_t changes);
+
+        /**
+         * Records the warm-starting impulses of a contact.
+         *
+         * @param contact   the contact
+         */
+        void WriteContactImpulses(const b2Contact& contact);
+
+        /**
+         * Records a step of the world.
+         *
+         * @param dt                    the step size
+         * @param velocityIterations    the number of velocity iterations
+         * @param positionIterations    the number of position iterations
+         * @param hash                  the state hash after the step
+         */
+        void WriteStep(float dt, int32 velocityIterations, int32 positionIterations, uint64_t hash);
+
+    private:
+        /** The recording file. */
+        std::ofstream out;
+
+        /** Temporary buffer used to reverse the order of fixtures. */
+        std::vector<const b2Fixture*> fixtures;
+
+        /**
+         * Writes a value in native byte order.
+         *
+         * @param value the value to write
+         */
+        template <typename T>
+        void Put(const T& value) {
+            out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        /**
+         * Writes the id of a body.
+         *
+         * @param body  the body
+         */
+        void PutId(const b2Body& body) {
+            Put<uint64_t>(reinterpret_cast<uintptr_t>(&body));
+        }
+
+        /**
+         * Writes a capacity.
+         *
+         * @param capacity  the capacity
+         */
+        void PutCapacity(const WorldCapacity& capacity);
+
+        /**
+         * Writes a fixture including its shape.
+         *
+         * @param fixture   the fixture
+         */
+        void PutFixture(const b2Fixture& fixture);
+    };
+
+} // end of namespace
@@ -0,0 +1,116 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+// Local includes
+#include "WorkerPool.h"
+
+// C++ Standard Library includes
+#include <algorithm>
+
+using namespace std;
+
+namespace astu::suite2d {
+
+    WorkerPool::WorkerPool(unsigned int numWorkers)
+        : generation(0)
+        , terminate(false)
+        , jobFunc(nullptr)
+        , jobCount(0)
+        , jobGrain(1)
+        , nextIndex(0)
+        , busyWorkers(0)
+    {
+        workers.reserve(numWorkers);
+        for (unsigned int i = 0; i < numWorkers; ++i) {
+            workers.emplace_back(&WorkerPool::WorkerMain, this);
+        }
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        {
+            lock_guard<std::mutex> lock(stateMutex);
+            terminate = true;
+        }
+        workAvailable.notify_all();
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    void WorkerPool::ParallelFor(size_t count, size_t grain, const RangeFunc& func)
+    {
+        if (count == 0) {
+            return;
+        }
+        grain = max<size_t>(grain, 1);
+
+        // Not worth waking up any workers.
+        if (workers.empty() || count <= grain) {
+            func(0, count);
+            return;
+        }
+
+        lock_guard<std::mutex> jobLock(jobMutex);
+        {
+            lock_guard<std::mutex> lock(stateMutex);
+            jobFunc = &func;
+            jobCount = count;
+            jobGrain = grain;
+            nextIndex.store(0, memory_order_relaxed);
+            busyWorkers = workers.size();
+            ++generation;
+        }
+        workAvailable.notify_all();
+
+        ProcessChunks();
+
+        unique_lock<std::mutex> lock(stateMutex);
+        workDone.wait(lock, [this] { return busyWorkers == 0; });
+        jobFunc = nullptr;
+    }
+
+    void WorkerPool::ProcessChunks()
+    {
+        while (true) {
+            size_t begin = nextIndex.fetch_add(jobGrain, memory_order_relaxed);
+            if (begin >= jobCount) {
+                break;
+            }
+            (*jobFunc)(begin, min(begin + jobGrain, jobCount));
+        }
+    }
+
+    void WorkerPool::WorkerMain()
+    {
+        size_t lastGeneration = 0;
+
+        while (true) {
+            {
+                unique_lock<std::mutex> lock(stateMutex);
+                workAvailable.wait(lock, [this, lastGeneration] {
+                    return terminate || generation != lastGeneration;
+                });
+
+                if (terminate) {
+                    return;
+                }
+                lastGeneration = generation;
+            }
+
+            ProcessChunks();
+
+            {
+                lock_guard<std::mutex> lock(stateMutex);
+                --busyWorkers;
+            }
+            workDone.notify_one();
+        }
+    }
+
+} // end of namespace
@@ -0,0 +1,114 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+#pragma once
+
+// C++ Standard Library includes
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace astu::suite2d {
+
+    /**
+     * A fixed set of worker threads used to process index ranges in parallel.
+     *
+     * Work is handed out in chunks from a shared counter, hence threads
+     * finishing early simply grab the next chunk. The calling thread takes
+     * part in the processing and returns once all chunks are done.
+     */
+    class WorkerPool {
+    public:
+
+        /** The function type used to process a range of indices. */
+        using RangeFunc = std::function<void(size_t begin, size_t end)>;
+
+        /**
+         * Constructor.
+         *
+         * @param numWorkers    the number of worker threads to spawn
+         */
+        explicit WorkerPool(unsigned int numWorkers);
+
+        /**
+         * Destructor, joins all worker threads.
+         */
+        ~WorkerPool();
+
+        /**
+         * Returns the number of threads processing ranges.
+         *
+         * This includes the calling thread.
+         *
+         * @return the number of threads
+         */
+        unsigned int GetNumThreads() const {
+            return static_cast<unsigned int>(workers.size()) + 1;
+        }
+
+        /**
+         * Processes the index range [0, count) in parallel.
+         *
+         * @param count the number of indices to process
+         * @param grain the number of indices processed as one chunk
+         * @param func  the function processing a sub-range
+         */
+        void ParallelFor(size_t count, size_t grain, const RangeFunc& func);
+
+    private:
+        /** The worker threads. */
+        std::vector<std::thread> workers;
+
+        /** Serializes calls to ParallelFor. */
+        std::mutex jobMutex;
+
+        /** Guards the job state. */
+        std::mutex stateMutex;
+
+        /** Used to wake up worker threads. */
+        std::condition_variable workAvailable;
+
+        /** Used to signal completion of the current job. */
+        std::condition_variable workDone;
+
+        /** Incremented for each new job. */
+        size_t generation;
+
+        /** Whether the worker threads should terminate. */
+        bool terminate;
+
+        /** The function of the current job. */
+        const RangeFunc* jobFunc;
+
+        /** The number of indices of the current job. */
+        size_t jobCount;
+
+        /** The chunk size of the current job. */
+        size_t jobGrain;
+
+        /** The next index to be processed. */
+        std::atomic<size_t> nextIndex;
+
+        /** The number of workers still busy with the current job. */
+        size_t busyWorkers;
+
+        /**
+         * Processes chunks of the current job until none are left.
+         */
+        void ProcessChunks();
+
+        /**
+         * The main function of the worker threads.
+         */
+        void WorkerMain();
+    };
+
+} // end of namespace
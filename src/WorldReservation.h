@@ -0,0 +1,48 @@
+/*
+ * ASTU/Box2D
+ * An integration of Erin Catto's 2D Physics Engine to AST-Utilities.
+ *
+ * Copyright (c) 2020, 2021 Roman Divotkey. All rights reserved.
+ */
+
+#pragma once
+
+// Local includes
+#include "Box2DMemory.h"
+
+// C++ Standard Library includes
+#include <cstddef>
+
+// Forward declaration
+class b2World;
+
+namespace astu::suite2d {
+
+    /**
+     * The memory allocated by reserving capacity for a world.
+     */
+    struct ReservedMemory {
+
+        /** The bytes kept by the block allocator. */
+        size_t blockBytes = 0;
+
+        /** The number of broad-phase nodes used at the peak. */
+        size_t treeNodes = 0;
+    };
+
+    /**
+     * Reserves capacity by creating and destroying placeholder objects.
+     *
+     * Contacts are created by stepping the world, which must neither
+     * affect existing bodies nor report contact events, hence contacts
+     * are only reserved for empty worlds without contact listener.
+     * Replays reserve capacity in the same way, which yields the same
+     * broad-phase proxies for the bodies created afterwards.
+     *
+     * @param world     the world
+     * @param capacity  the capacity to reserve
+     * @return the allocated memory
+     */
+    ReservedMemory ReserveWorldMemory(b2World& world, const WorldCapacity& capacity);
+
+} // end of namespace